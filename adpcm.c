@@ -0,0 +1,121 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * adpcm.c
+ *
+ * ADPCM implementation file
+ *
+ * Standard IMA/DVI ADPCM step and index tables.
+ * Encode and decode share the same reconstruction
+ * so the decoder tracks the encoder exactly.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stddef.h>
+#include <assert.h>
+#include "adpcm.h"
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_word(addr)   (*(const uint16_t *)(addr))
+#define pgm_read_byte(addr)   (*(const uint8_t *)(addr))
+#endif
+
+#define INDEX_MAX    88
+
+static const uint16_t step_table[INDEX_MAX + 1] PROGMEM = {
+   7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+   19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+   50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+   130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+   337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+   876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+   2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+   5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+   15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t index_table[8] PROGMEM = {
+   -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/* Private */
+
+/* Rebuilds the predictor and adapts the step from a code.
+ * Used by both directions, the encoder must see exactly
+ * what the decoder will reconstruct.
+ * 16 bit only, the AVR has no 32 bit arithmetic. The
+ * predictor is saturated in offset binary (+ 0x8000)
+ * where the limits are 0 and 0xFFFF.
+ */
+
+static int16_t update(adpcm_t *adpcm, uint8_t code, uint16_t step) {
+   uint16_t vpdiff = step >> 3;
+   uint16_t biased = (uint16_t) adpcm->predictor + 0x8000;
+   int8_t index;
+
+   if (code & 4) vpdiff += step;
+   if (code & 2) vpdiff += step >> 1;
+   if (code & 1) vpdiff += step >> 2;
+
+   if (code & 8) {
+      biased = vpdiff > biased ? 0 : biased - vpdiff;
+   } else {
+      biased = vpdiff > 0xFFFF - biased ? 0xFFFF : biased + vpdiff;
+   }
+
+   index = adpcm->index + (int8_t) pgm_read_byte(&index_table[code & 7]);
+   if (index < 0) index = 0;
+   if (index > INDEX_MAX) index = INDEX_MAX;
+
+   adpcm->predictor = (int16_t) (biased - 0x8000);
+   adpcm->index = index;
+
+   return adpcm->predictor;
+}
+
+/* Public */
+
+void adpcm_init(adpcm_t *adpcm) {
+   assert(adpcm != NULL);
+   adpcm->predictor = 0;
+   adpcm->index = 0;
+}
+
+uint8_t adpcm_encode(adpcm_t *adpcm, int16_t sample) {
+   assert(adpcm != NULL);
+   uint16_t step = pgm_read_word(&step_table[adpcm->index]);
+   uint16_t diff;
+   uint8_t code = 0;
+
+   /* |sample - predictor| fits 16 bits unsigned */
+   if (sample < adpcm->predictor) {
+      code = 8;
+      diff = (uint16_t) adpcm->predictor - (uint16_t) sample;
+   } else {
+      diff = (uint16_t) sample - (uint16_t) adpcm->predictor;
+   }
+
+   if (diff >= step) {
+      code |= 4;
+      diff -= step;
+   }
+   if (diff >= (step >> 1)) {
+      code |= 2;
+      diff -= step >> 1;
+   }
+   if (diff >= (step >> 2)) {
+      code |= 1;
+   }
+
+   update(adpcm, code, step);
+   return code;
+}
+
+int16_t adpcm_decode(adpcm_t *adpcm, uint8_t code) {
+   assert(adpcm != NULL);
+   return update(adpcm, code & 0x0F, pgm_read_word(&step_table[adpcm->index]));
+}
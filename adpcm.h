@@ -0,0 +1,36 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * adpcm.h
+ *
+ * ADPCM Header file
+ *
+ * 4 bit IMA/DVI ADPCM codec. One 16 bit sample in,
+ * one 4 bit code out, and the other way around.
+ * Compiles for the AVR and for the host, so tools
+ * can produce streams the firmware decodes.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _ADPCM_H_
+#define _ADPCM_H_
+
+#include <stdint.h>
+
+/* adpcm_t
+ * Codec state. Encoder and decoder must start with
+ * the same state to stay in sync. Kept public so it
+ * can be statically allocated and used from ISRs.
+ */
+
+typedef struct _adpcm_t {
+   int16_t predictor;
+   uint8_t index;
+} adpcm_t;
+
+void                             adpcm_init(adpcm_t *adpcm);
+uint8_t                          adpcm_encode(adpcm_t *adpcm, int16_t sample);
+int16_t                          adpcm_decode(adpcm_t *adpcm, uint8_t code);
+
+#endif /* _ADPCM_H_ */
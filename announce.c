@@ -0,0 +1,210 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * announce.c
+ *
+ * Announce implementation file
+ *
+ * Two heaps per idle policy, so an idle only
+ * announcement waiting for the channel never hides
+ * the ones behind it. Queued announcements wait in the
+ * timer heap, ordered by due time. Once due they move
+ * to the ready heap, ordered by priority, so among the
+ * due ones the most important plays first whatever its
+ * due time. Checking for a due announcement is a look
+ * at the tops, queueing and playing one is a sift,
+ * O(log n). Each announcement keeps its heap slot so it
+ * can be moved or cancelled in place.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "announce.h"
+
+#define ANNOUNCE_NO_SLOT   0xFF
+
+typedef struct _heap_t {
+   announce_t *entry[ANNOUNCE_MAX];
+   unsigned char count;
+   bool (*before)(announce_t *a, announce_t *b);
+} heap_t;
+
+/* Private */
+
+/* Seconds wrap, compare by difference. Good while
+ * periods stay under 32767 sec, ~9 hours.
+ */
+
+static bool is_due(announce_t *announce, unsigned int now) {
+   return (int) (now - announce->due) >= 0;
+}
+
+/* Timer heap order, due time then priority */
+
+static bool by_due(announce_t *a, announce_t *b) {
+   int diff = (int) (a->due - b->due);
+
+   if (diff != 0) return diff < 0;
+   return a->priority < b->priority;
+}
+
+/* Ready heap order, priority then due time */
+
+static bool by_priority(announce_t *a, announce_t *b) {
+   if (a->priority != b->priority) return a->priority < b->priority;
+   return (int) (a->due - b->due) < 0;
+}
+
+/* Per idle policy, a timer and a ready heap */
+
+static heap_t timers[2] = { { .before = by_due }, { .before = by_due } };
+static heap_t ready[2] = { { .before = by_priority }, { .before = by_priority } };
+
+static heap_t *heap_of(announce_t *announce) {
+   return announce->ready ? &ready[announce->idle_only] : &timers[announce->idle_only];
+}
+
+static void heap_set(heap_t *heap, unsigned char slot, announce_t *announce) {
+   heap->entry[slot] = announce;
+   announce->slot = slot;
+}
+
+static void sift_up(heap_t *heap, unsigned char slot) {
+   announce_t *announce = heap->entry[slot];
+
+   while (slot > 0) {
+      unsigned char parent = (slot - 1) / 2;
+      if (!heap->before(announce, heap->entry[parent])) break;
+      heap_set(heap, slot, heap->entry[parent]);
+      slot = parent;
+   }
+
+   heap_set(heap, slot, announce);
+}
+
+static void sift_down(heap_t *heap, unsigned char slot) {
+   announce_t *announce = heap->entry[slot];
+
+   while (true) {
+      unsigned char child = 2 * slot + 1;
+      if (child >= heap->count) break;
+      if (child + 1 < heap->count && heap->before(heap->entry[child + 1], heap->entry[child])) child++;
+      if (!heap->before(heap->entry[child], announce)) break;
+      heap_set(heap, slot, heap->entry[child]);
+      slot = child;
+   }
+
+   heap_set(heap, slot, announce);
+}
+
+static void heap_push(heap_t *heap, announce_t *announce) {
+   heap_set(heap, heap->count, announce);
+   heap->count++;
+   sift_up(heap, announce->slot);
+}
+
+static void heap_remove(heap_t *heap, announce_t *announce) {
+   unsigned char slot = announce->slot;
+   announce_t *moved;
+
+   announce->slot = ANNOUNCE_NO_SLOT;
+   heap->count--;
+   if (slot == heap->count) return;
+
+   /* Last entry fills the hole, then goes down or up */
+   moved = heap->entry[heap->count];
+   heap_set(heap, slot, moved);
+   sift_down(heap, slot);
+   sift_up(heap, moved->slot);
+}
+
+/* Moves every due announcement of a policy to its ready heap */
+
+static void heap_promote(unsigned char policy, unsigned int now) {
+   heap_t *timer = &timers[policy];
+
+   while (timer->count > 0 && is_due(timer->entry[0], now)) {
+      announce_t *announce = timer->entry[0];
+
+      heap_remove(timer, announce);
+      announce->ready = true;
+      heap_push(&ready[policy], announce);
+   }
+}
+
+static announce_t *heap_top(heap_t *heap) {
+   return heap->count > 0 ? heap->entry[0] : NULL;
+}
+
+/* Public */
+
+void announce_init(announce_t *announce, announce_play_t play, const void *arg, unsigned int period, unsigned char priority, bool idle_only) {
+   announce->play = play;
+   announce->arg = arg;
+   announce->period = period;
+   announce->priority = priority;
+   announce->idle_only = idle_only;
+   announce->due = 0;
+   announce->slot = ANNOUNCE_NO_SLOT;
+   announce->ready = false;
+}
+
+/* announce_schedule
+ * Queues the announcement delay seconds from now,
+ * or moves it there if already queued.
+ * False if the queue is full.
+ */
+
+bool announce_schedule(announce_t *announce, unsigned int now, unsigned int delay) {
+   unsigned char policy = announce->idle_only;
+
+   if (announce->slot != ANNOUNCE_NO_SLOT) heap_remove(heap_of(announce), announce);
+   if (timers[policy].count + ready[policy].count >= ANNOUNCE_MAX) return false;
+
+   announce->due = now + delay;
+   announce->ready = false;
+   heap_push(&timers[policy], announce);
+
+   return true;
+}
+
+void announce_cancel(announce_t *announce) {
+   if (announce->slot != ANNOUNCE_NO_SLOT) heap_remove(heap_of(announce), announce);
+}
+
+/* announce_pending
+ * Queued and due, but not played yet.
+ */
+
+bool announce_pending(announce_t *announce, unsigned int now) {
+   if (announce->slot == ANNOUNCE_NO_SLOT) return false;
+   return announce->ready || is_due(announce, now);
+}
+
+/* announce_next
+ * Takes the due announcement with the lowest priority
+ * value, the earliest due among equals. Idle only ones
+ * just when idle. Periodic ones are queued again
+ * period seconds from now. NULL if none is due.
+ */
+
+announce_t *announce_next(unsigned int now, bool idle) {
+   announce_t *announce;
+   announce_t *waiting;
+
+   heap_promote(0, now);
+   heap_promote(1, now);
+
+   announce = heap_top(&ready[0]);
+   waiting = idle ? heap_top(&ready[1]) : NULL;
+
+   if (waiting != NULL && (announce == NULL || by_priority(waiting, announce))) announce = waiting;
+   if (announce == NULL) return NULL;
+
+   heap_remove(heap_of(announce), announce);
+   if (announce->period > 0) announce_schedule(announce, now, announce->period);
+
+   return announce;
+}
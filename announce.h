@@ -0,0 +1,56 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * announce.h
+ *
+ * Announce Header file
+ *
+ * Announcement scheduler. Each announcement (voice ID,
+ * morse ID, TOT info, bulletins) has a play function,
+ * a period, a priority and an idle policy. Among the
+ * due ones the lowest priority value plays first, the
+ * earliest due breaking ties. Binary heaps keep the
+ * next one on top, see announce.c.
+ * Main loop only, times are in seconds.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _ANNOUNCE_H_
+#define _ANNOUNCE_H_
+
+#include <stdbool.h>
+
+/* ANNOUNCE_MAX
+ * Announcements queued at the same time.
+ */
+
+#define ANNOUNCE_MAX       8
+
+typedef void (*announce_play_t)(const void *arg);
+
+/* announce_t
+ * period 0 is a one shot, it leaves the queue once played.
+ * Lower priority values play first.
+ * idle_only ones wait for a free channel, see announce_next.
+ * Public so it can be statically allocated.
+ */
+
+typedef struct _announce_t {
+   announce_play_t play;
+   const void *arg;
+   unsigned int period;
+   unsigned char priority;
+   bool idle_only;
+   unsigned int due;       /* Scheduler state */
+   unsigned char slot;
+   bool ready;
+} announce_t;
+
+void                             announce_init(announce_t *announce, announce_play_t play, const void *arg, unsigned int period, unsigned char priority, bool idle_only);
+bool                             announce_schedule(announce_t *announce, unsigned int now, unsigned int delay);
+void                             announce_cancel(announce_t *announce);
+bool                             announce_pending(announce_t *announce, unsigned int now);
+announce_t *                     announce_next(unsigned int now, bool idle);
+
+#endif /* _ANNOUNCE_H_ */
@@ -0,0 +1,214 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * audio.c
+ *
+ * Audio implementation file
+ *
+ * RX audio in on ADC1 (PC1), audio out as 8 bit PWM
+ * on OC2A (PB3) at 31.25 kHz, RC filtered on the board.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "config.h"
+#include "io.h"
+#include "adpcm.h"
+#include "audio.h"
+#include "squelch.h"
+
+/* AUDIO_DELAY_BYTES
+ * Delay line size. Two 4 bit samples per byte, so
+ * 768 bytes hold 1536 samples = 153.6 ms at 10 kHz.
+ * Must be a multiple of 64, one gate map byte.
+ */
+
+#define AUDIO_DELAY_BYTES     768
+#define AUDIO_DELAY_SAMPLES   (AUDIO_DELAY_BYTES * 2)
+
+/* AUDIO_BLOCK_SHIFT & AUDIO_TAIL_MS
+ * The gate (mute) state is kept per block of 16 samples,
+ * 1.6 ms, one bit each. When the gate closes, the audio
+ * still in the delay line from AUDIO_TAIL_MS before the
+ * carrier dropped is muted too, that is where the squelch
+ * tail sits. The gate closes only after the COR filter
+ * release, so the guard is the release plus the tail,
+ * see audio_delay_init(). Key ups shorter than the guard
+ * never reach the TX. The guard blocks are cleared one
+ * per sample by the ADC ISR, done long before they are
+ * played again.
+ */
+
+#define AUDIO_BLOCK_SHIFT     4
+#define AUDIO_BLOCK_MASK      ((1 << AUDIO_BLOCK_SHIFT) - 1)
+#define AUDIO_BLOCKS          (AUDIO_DELAY_SAMPLES >> AUDIO_BLOCK_SHIFT)
+#define AUDIO_TAIL_MS         40
+
+#define AUDIO_DAC_SILENCE     128
+
+static volatile bool dac_claimed       = false;
+
+#if AUDIO_DELAY_ENABLED
+static uint8_t delay_line[AUDIO_DELAY_BYTES];
+static uint8_t gate_map[AUDIO_BLOCKS / 8];
+static uint16_t position               = 0;
+static adpcm_t encoder;
+static adpcm_t decoder;
+static volatile bool gate_open         = false;
+static bool gate_out                   = false;
+static uint8_t guard_blocks            = 0;
+static uint8_t guard_block             = 0;
+static uint8_t guard_left              = 0;
+#endif
+
+/******************************************************************************
+ * ADC ISR
+ *****************************************************************************/
+
+/* ADC CONVERSION COMPLETE ISR
+ * Runs at every sample, 100us. Feeds the noise squelch.
+ * Reads the oldest sample out of the delay line, stores
+ * the new one in its place and plays the old one if its
+ * block was open, unless someone else claimed the DAC.
+ * Only compiled in when something uses the ADC.
+ */
+
+#if AUDIO_DELAY_ENABLED || SQUELCH_MODE != SQUELCH_MODE_COR
+
+ISR(ADC_vect) {
+   int8_t sample = ADCH - 128;
+
+#if SQUELCH_MODE != SQUELCH_MODE_COR
+   squelch_sample(sample);
+#endif
+
+#if AUDIO_DELAY_ENABLED
+   int16_t in = (int16_t) sample << 8;
+   uint8_t *cell = &delay_line[position >> 1];
+   int16_t out;
+
+   if (position & 1) {
+      out = adpcm_decode(&decoder, *cell >> 4);
+      *cell = (*cell & 0x0F) | (adpcm_encode(&encoder, in) << 4);
+   } else {
+      out = adpcm_decode(&decoder, *cell & 0x0F);
+      *cell = (*cell & 0xF0) | adpcm_encode(&encoder, in);
+   }
+
+   if ((position & AUDIO_BLOCK_MASK) == 0) {
+      uint8_t block = position >> AUDIO_BLOCK_SHIFT;
+      uint8_t mask = _BV(block & 7);
+
+      gate_out = gate_map[block >> 3] & mask;
+      if (gate_open) {
+         gate_map[block >> 3] |= mask;
+      } else {
+         gate_map[block >> 3] &= ~mask;
+      }
+   }
+
+   if (guard_left) {
+      gate_map[guard_block >> 3] &= ~_BV(guard_block & 7);
+      guard_block = guard_block ? guard_block - 1 : AUDIO_BLOCKS - 1;
+      guard_left--;
+   }
+
+   if (++position >= AUDIO_DELAY_SAMPLES) position = 0;
+
+   if (!dac_claimed) OCR2A = gate_out ? (out >> 8) + 128 : AUDIO_DAC_SILENCE;
+#endif
+}
+
+#endif
+
+/******************************************************************************
+ * PUBLIC
+ *****************************************************************************/
+
+/* TIMER 2 as PWM DAC
+ *
+ * Fast PWM, 8 bit, no prescaler. 8MHz / 256 = 31.25 kHz,
+ * way above the audio band. Non inverting output on OC2A.
+ */
+
+void audio_dac_init(void) {
+   IO_OUTPUT(IO_PWM_OUT);
+   OCR2A  = AUDIO_DAC_SILENCE;
+   TIMSK2 = 0;
+   TCCR2A = (1 << COM2A1) | (1 << WGM21) | (1 << WGM20);
+   TCCR2B = (1 << CS20);
+}
+
+/* audio_dac_claim
+ * Takes the DAC away from the delay line, e.g. for
+ * the voice ID. The delay line keeps running.
+ */
+
+void audio_dac_claim(bool claim) {
+   dac_claimed = claim;
+   if (!claim) OCR2A = AUDIO_DAC_SILENCE;
+}
+
+void audio_dac_write(unsigned char level) {
+   OCR2A = level;
+}
+
+/* ADC
+ *
+ * AVcc reference, left adjusted result (we only read ADCH),
+ * input ADC1. Auto triggered by TIMER 0 compare match A (ADTS = 011).
+ * Prescaler 32 gives a 250 kHz ADC clock at 8MHz, a conversion
+ * takes 13.5 cycles = 54us, well inside the 100us tick.
+ * Needed by the delay line and the noise squelch.
+ */
+
+void audio_adc_init(void) {
+   IO_INPUT(IO_RX_AUDIO);
+   DIDR0  = (1 << ADC1D);
+   ADMUX  = (1 << REFS0) | (1 << ADLAR) | (1 << MUX0);
+   ADCSRB = (1 << ADTS1) | (1 << ADTS0);
+   ADCSRA = (1 << ADEN) | (1 << ADATE) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS0);
+}
+
+/* audio_delay_init
+ * The delay line is zeroed, which decodes as silence and
+ * leaves the decoder in the encoder initial state.
+ * release_ms is the COR filter release, the time from
+ * the carrier drop to audio_gate() closing.
+ * Call before interrupts are enabled.
+ */
+
+void audio_delay_init(unsigned int release_ms) {
+#if AUDIO_DELAY_ENABLED
+   unsigned long blocks = ((unsigned long) (release_ms + AUDIO_TAIL_MS) * (AUDIO_SAMPLE_RATE / 1000)) >> AUDIO_BLOCK_SHIFT;
+
+   guard_blocks = blocks < AUDIO_BLOCKS ? blocks : AUDIO_BLOCKS;
+   adpcm_init(&encoder);
+   adpcm_init(&decoder);
+#endif
+}
+
+/* audio_gate
+ * Called from the TIMER 0 ISR every tick with the
+ * wanted state. On close, hands the guard blocks
+ * already in the delay line to the ADC ISR, newest
+ * first. A close while the last guard is still being
+ * cleared carries its remaining blocks over. ISRs do
+ * not nest so this never races the ADC ISR.
+ */
+
+void audio_gate(bool open) {
+#if AUDIO_DELAY_ENABLED
+   if (open == gate_open) return;
+   gate_open = open;
+   if (open) return;
+
+   guard_block = position >> AUDIO_BLOCK_SHIFT;
+   guard_left += guard_blocks;
+   if (guard_left > AUDIO_BLOCKS) guard_left = AUDIO_BLOCKS;
+#endif
+}
@@ -0,0 +1,36 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * audio.h
+ *
+ * Audio Header file
+ *
+ * Digital RX audio path. The ADC samples the RX audio,
+ * a circular ADPCM delay line holds it back and the
+ * PWM DAC plays it out. Muting is decided while the
+ * audio is still in the delay line, so the squelch
+ * tail never reaches the transmitter.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _AUDIO_H_
+#define _AUDIO_H_
+
+#include <stdbool.h>
+
+/* AUDIO_SAMPLE_RATE
+ * The ADC is triggered by the TIMER 0 compare match,
+ * the 100us tick, so we sample at 10 kHz.
+ */
+
+#define AUDIO_SAMPLE_RATE     10000
+
+void                             audio_dac_init(void);
+void                             audio_dac_claim(bool claim);
+void                             audio_dac_write(unsigned char level);
+void                             audio_adc_init(void);
+void                             audio_delay_init(unsigned int release_ms);
+void                             audio_gate(bool open);
+
+#endif /* _AUDIO_H_ */
@@ -0,0 +1,86 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * config.h
+ *
+ * Config Header file
+ *
+ * Optional hardware features. Shared by main.c and the
+ * modules, so what a feature needs is only compiled in
+ * when it is enabled. The tuning of each feature stays
+ * in main.c. Each switch can also be given on the command
+ * line, e.g. -DTONE_ACCESS_ENABLED=true, the host benches
+ * do that for the module they test.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+#include <stdbool.h>
+
+/* SQUELCH_MODE
+ * Where the carrier detect comes from.
+ * SQUELCH_MODE_COR   receiver COR on PB5 only
+ * SQUELCH_MODE_NOISE noise squelch on the RX audio (ADC1, PC1) only,
+ *                    for radios without a usable COR line
+ * SQUELCH_MODE_BOTH  PB5 qualified by the noise squelch
+ * The noise squelch needs unsquelched (discriminator) RX audio.
+ *
+ * Default: SQUELCH_MODE_COR
+ */
+
+#define SQUELCH_MODE_COR                  0
+#define SQUELCH_MODE_NOISE                1
+#define SQUELCH_MODE_BOTH                 2
+#ifndef SQUELCH_MODE
+#define SQUELCH_MODE                      SQUELCH_MODE_COR
+#endif
+
+/* AUDIO_DELAY_ENABLED
+ * Digital RX audio path with a ~150 ms delay line.
+ * RX audio goes into ADC1 (PC1, biased at VCC/2) and the
+ * delayed audio comes out as PWM on PB3, RC filtered, in
+ * place of the RX audio at the 4066 input. The COR mute is
+ * then applied before the audio leaves the delay line so
+ * the squelch tail is not transmitted. TIMER 2 is used as
+ * the PWM DAC when enabled. The delay line takes ~780 bytes
+ * of RAM, only compiled in when enabled.
+ *
+ * Default: false, plain analog path through the 4066.
+ */
+
+#ifndef AUDIO_DELAY_ENABLED
+#define AUDIO_DELAY_ENABLED               false
+#endif
+
+/* VOICE_ID_ENABLED
+ * Plays the voice ID from flash (voice_clip.c, see make voice)
+ * as PWM on PB3 instead of triggering the external ISD board.
+ * PB3, RC filtered, goes where the ISD audio output went.
+ * With AUDIO_DELAY_ENABLED PB3 already feeds the 4066, which
+ * is then opened while the clip plays.
+ *
+ * Default: false, ISD board on IO_ISD_PLAY
+ */
+
+#ifndef VOICE_ID_ENABLED
+#define VOICE_ID_ENABLED                  false
+#endif
+
+/* TONE_ACCESS_ENABLED
+ * The repeater only keys up after a tone burst. The RX audio,
+ * squared up by a comparator, goes into ICP1 (PB0) and the
+ * TIMER 1 input capture measures its period, see tone.c.
+ * Once the repeater is up any key up goes through until the
+ * tail ends or the TOT trips.
+ *
+ * Default: false
+ */
+
+#ifndef TONE_ACCESS_ENABLED
+#define TONE_ACCESS_ENABLED               false
+#endif
+
+#endif /* _CONFIG_H_ */
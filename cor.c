@@ -0,0 +1,74 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * cor.c
+ *
+ * COR implementation file
+ *
+ * Inactive: the integrator counts up on active samples
+ * and down on inactive ones. Reaching attack goes active.
+ * Active: it is loaded with release and counts down on
+ * inactive samples, up (to release) on active ones.
+ * Reaching zero goes inactive. Constant time per tick.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stddef.h>
+#include <assert.h>
+#include "cor.h"
+
+/* Public */
+
+void cor_init(cor_t *cor, unsigned int attack, unsigned int release, unsigned int kerchunk) {
+   assert(cor != NULL);
+   cor->active = false;
+   cor->integrator = 0;
+   cor->duration = 0;
+   cor->attack = attack ? attack : 1;
+   cor->release = release ? release : 1;
+   cor->kerchunk = kerchunk ? kerchunk : 1;
+}
+
+cor_edge_t cor_update(cor_t *cor, bool raw) {
+   assert(cor != NULL);
+
+   if (!cor->active) {
+      if (raw) {
+         if (++cor->integrator >= cor->attack) {
+            cor->active = true;
+            cor->integrator = cor->release;
+            cor->duration = 0;
+            return COR_EDGE_UP;
+         }
+      } else if (cor->integrator > 0) {
+         cor->integrator--;
+      }
+      return COR_EDGE_NONE;
+   }
+
+   if (!raw) {
+      if (--cor->integrator == 0) {
+         cor->active = false;
+         return COR_EDGE_DOWN;
+      }
+   } else if (cor->integrator < cor->release) {
+      cor->integrator++;
+   }
+
+   if (cor->duration < cor->kerchunk) {
+      if (++cor->duration == cor->kerchunk) return COR_EDGE_QUALIFIED;
+   }
+
+   return COR_EDGE_NONE;
+}
+
+bool cor_active(cor_t *cor) {
+   assert(cor != NULL);
+   return cor->active;
+}
+
+bool cor_qualified(cor_t *cor) {
+   assert(cor != NULL);
+   return cor->active && cor->duration >= cor->kerchunk;
+}
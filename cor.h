@@ -0,0 +1,48 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * cor.h
+ *
+ * COR Header file
+ *
+ * Digital COR filter. An up/down integrator with
+ * separate attack and release times, so a single
+ * noisy sample only delays the edge instead of
+ * toggling the state. Also flags key ups that
+ * lasted long enough not to be a kerchunk.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _COR_H_
+#define _COR_H_
+
+#include <stdbool.h>
+
+typedef enum {
+   COR_EDGE_NONE,
+   COR_EDGE_UP,            /* Filtered COR went active */
+   COR_EDGE_DOWN,          /* Filtered COR went inactive */
+   COR_EDGE_QUALIFIED      /* Key up lasted the kerchunk time */
+} cor_edge_t;
+
+/* cor_t
+ * Filter state, times in ticks (calls to cor_update).
+ * Public so it can be statically allocated for the ISR.
+ */
+
+typedef struct _cor_t {
+   bool active;
+   unsigned int integrator;
+   unsigned int duration;
+   unsigned int attack;
+   unsigned int release;
+   unsigned int kerchunk;
+} cor_t;
+
+void                             cor_init(cor_t *cor, unsigned int attack, unsigned int release, unsigned int kerchunk);
+cor_edge_t                       cor_update(cor_t *cor, bool raw);
+bool                             cor_active(cor_t *cor);
+bool                             cor_qualified(cor_t *cor);
+
+#endif /* _COR_H_ */
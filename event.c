@@ -0,0 +1,69 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * event.c
+ *
+ * Event implementation file
+ *
+ * head is only written by the producer, tail only by
+ * the consumer. Both are single bytes, so reads and
+ * writes are atomic on the AVR and no locking is needed.
+ * The slot is filled before head moves, the slot is
+ * copied out before tail moves.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stddef.h>
+#include <assert.h>
+#include "event.h"
+
+#define EVENT_QUEUE_MASK   (EVENT_QUEUE_SIZE - 1)
+
+#if (EVENT_QUEUE_SIZE & EVENT_QUEUE_MASK) != 0
+#error "EVENT_QUEUE_SIZE must be a power of 2"
+#endif
+
+static volatile event_t queue[EVENT_QUEUE_SIZE];
+static volatile unsigned char head      = 0;
+static volatile unsigned char tail      = 0;
+static volatile unsigned char overflows = 0;
+
+/* Public */
+
+/* event_push
+ * Constant time. When full the event is dropped
+ * and counted as an overflow.
+ */
+
+bool event_push(unsigned char type) {
+   unsigned char next = (head + 1) & EVENT_QUEUE_MASK;
+
+   if (next == tail) {
+      if (overflows < 255) overflows++;
+      return false;
+   }
+
+   queue[head].type = type;
+   head = next;
+   return true;
+}
+
+bool event_pop(event_t *event) {
+   assert(event != NULL);
+   unsigned char index = tail;
+
+   if (index == head) return false;
+
+   event->type = queue[index].type;
+   tail = (index + 1) & EVENT_QUEUE_MASK;
+   return true;
+}
+
+/* event_overflows
+ * Number of dropped events since boot, saturates at 255.
+ */
+
+unsigned char event_overflows(void) {
+   return overflows;
+}
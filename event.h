@@ -0,0 +1,53 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * event.h
+ *
+ * Event Header file
+ *
+ * Single producer, single consumer lock free ring of
+ * events. The ISRs are the producer (they
+ * do not nest, so together they are a single context)
+ * and the main loop is the consumer.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _EVENT_H_
+#define _EVENT_H_
+
+#include <stdbool.h>
+
+/* EVENT_QUEUE_SIZE
+ * Number of slots, must be a power of 2.
+ * One slot is always kept free.
+ */
+
+#define EVENT_QUEUE_SIZE   16
+
+typedef enum {
+   EVENT_COR_UP,           /* Receiver COR went active */
+   EVENT_COR_DOWN,         /* Receiver COR went inactive */
+   EVENT_COR_QUALIFIED,    /* Key up longer than a kerchunk */
+   EVENT_TAIL_END,         /* Tail time elapsed */
+   EVENT_TOT_EXPIRED,      /* Time out timer elapsed */
+   EVENT_TOT_INHIBIT_END,  /* No RX during the TOT penalty */
+   EVENT_CHANNEL_IDLE,     /* No key up for the ID wait time */
+   EVENT_VOICE_DONE,       /* Voice clip finished playing */
+   EVENT_TONE_BURST        /* Access tone burst detected */
+} event_type_t;
+
+typedef struct _event_t {
+   unsigned char type;
+} event_t;
+
+/* ISR context only */
+
+bool                             event_push(unsigned char type);
+
+/* Main loop */
+
+bool                             event_pop(event_t *event);
+unsigned char                    event_overflows(void);
+
+#endif /* _EVENT_H_ */
@@ -0,0 +1,44 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * io.c
+ *
+ * IO implementation file
+ *
+ * Registers of the host build, see
+ * tools/host/avr/io.h, and its PINx write.
+ * Nothing here for the AVR build.
+ *
+ * José Miguel Fonte
+ */
+
+#include "io.h"
+
+#ifndef __AVR__
+
+volatile uint8_t  PINB   = 0;
+volatile uint8_t  DDRB   = 0;
+volatile uint8_t  PORTB  = 0;
+volatile uint8_t  PINC   = 0;
+volatile uint8_t  DDRC   = 0;
+volatile uint8_t  PORTC  = 0;
+volatile uint8_t  PIND   = 0;
+volatile uint8_t  DDRD   = 0;
+volatile uint8_t  PORTD  = 0;
+volatile uint8_t  TCCR1B = 0;
+volatile uint8_t  TIMSK1 = 0;
+volatile uint16_t ICR1   = 0;
+
+/* io_pin_write
+ * A 1 written to a PINx bit toggles the PORTx bit,
+ * 0 bits are left alone. PINx itself, the input
+ * stand in, does not change.
+ */
+
+void io_pin_write(volatile uint8_t *pin, uint8_t mask) {
+   if (pin == &PINB) PORTB ^= mask;
+   if (pin == &PINC) PORTC ^= mask;
+   if (pin == &PIND) PORTD ^= mask;
+}
+
+#endif /* __AVR__ */
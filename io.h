@@ -4,7 +4,10 @@
  * io.h
  *
  * IO Header file
- * 
+ *
+ * A pin is a port letter and a bit mask, both
+ * constants, so the helpers below compile to a
+ * single sbi, cbi, sbis or sbic for one pin.
  *
  * José Miguel Fonte
  */
@@ -13,24 +16,46 @@
 #define _IO_H_
 
 #include <avr/io.h>
+#include <util/atomic.h>
 
 /* IO_RPT_RX
  * PIN B5, pin 19, as input for Receiver COR
  */
 
-#define IO_RPT_RX    PINB5
+#define IO_RPT_RX    B, _BV(PINB5)
+
+/* IO_TONE_IN
+ * PIN B0 (ICP1), pin 14, as input for the squared up
+ * RX audio of the tone burst detector.
+ */
+
+#define IO_TONE_IN   B, _BV(PINB0)
+
+/* IO_PWM_OUT
+ * PIN B3 (OC2A), pin 17, as output for the PWM DAC,
+ * delayed RX audio and voice ID.
+ */
+
+#define IO_PWM_OUT   B, _BV(PORTB3)
 
 /* IO_BEEP
  * PIN C0, pin 23, as output for audio beep and morse
  */
 
-#define IO_BEEP      PORTC0
+#define IO_BEEP      C, _BV(PORTC0)
+
+/* IO_RX_AUDIO
+ * PIN C1 (ADC1), pin 24, as input for the RX audio of
+ * the delay line and the noise squelch.
+ */
+
+#define IO_RX_AUDIO  C, _BV(PINC1)
 
 /* IO_PTT
  * PIN D0, pin 2, as output for PTT control
  */
 
-#define IO_PTT       PORTD0
+#define IO_PTT       D, _BV(PORTD0)
 
 /* IO_RX_UNMUTE
  * PIN D1, pin 3, as output to control receiver
@@ -38,7 +63,7 @@
  * A digital one (1) unmutes the receiver.
  */
 
-#define IO_RX_UNMUTE PORTD1
+#define IO_RX_UNMUTE D, _BV(PORTD1)
 
 /* IO_LED_x
  * Uses PIN D2, D3 and D4 (pin 4, 5 and 6) as output
@@ -46,24 +71,68 @@
  * TX led flashing equals ID.
  */
 
-#define IO_LED_RX    PORTD2
-#define IO_LED_TX    PORTD3
-#define IO_LED_TOT   PORTD4
+#define IO_LED_RX    D, _BV(PORTD2)
+#define IO_LED_TX    D, _BV(PORTD3)
+#define IO_LED_TOT   D, _BV(PORTD4)
 
 /* IO_ISD_PLAY
  * Uses PIN D5, pin 11, as output for ISD play control.
  */
 
-#define IO_ISD_PLAY  PORTD5
+#define IO_ISD_PLAY  D, _BV(PORTD5)
+
+/* IO_TX
+ * PTT and TX led, always switched together.
+ */
+
+#define IO_TX        D, (_BV(PORTD0) | _BV(PORTD3))
 
 /* IO HELPER FUNCTIONS
- * These macros just beautify the code to me.
- * Otherwise redundant
+ * Take a pin from above, e.g. IO_ENABLE(IO_PTT).
+ * One pin is one sbi/cbi, atomic by itself. More than
+ * one pin is a read, modify and write of the port, done
+ * with interrupts off as the TIMER 0 ISR also writes
+ * PORTD. The check is on constants, so it costs nothing.
+ * IO_TOGGLE writes PINx, which toggles the pins in one
+ * write.
+ */
+
+#define IO_ENABLE(pin)           IO_ENABLE_(pin)
+#define IO_DISABLE(pin)          IO_DISABLE_(pin)
+#define IO_TOGGLE(pin)           IO_TOGGLE_(pin)
+#define IO_IS_ENABLED(pin)       IO_IS_ENABLED_(pin)
+#define IO_OUTPUT(pin)           IO_OUTPUT_(pin)
+#define IO_INPUT(pin)            IO_INPUT_(pin)
+
+#define IO_ENABLE_(port, mask)   IO_UPDATE(PORT ## port |= (mask), mask)
+#define IO_DISABLE_(port, mask)  IO_UPDATE(PORT ## port &= ~(mask), mask)
+#define IO_OUTPUT_(port, mask)   IO_UPDATE(DDR ## port |= (mask), mask)
+#define IO_INPUT_(port, mask)    IO_UPDATE(DDR ## port &= ~(mask), mask)
+#define IO_IS_ENABLED_(port, mask) ((PIN ## port & (mask)) != 0)
+
+#define IO_SINGLE(mask)          (((mask) & ((mask) - 1)) == 0)
+
+#define IO_UPDATE(update, mask)                    \
+   do {                                            \
+      if (IO_SINGLE(mask)) {                       \
+         update;                                   \
+      } else {                                     \
+         ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {       \
+            update;                                \
+         }                                         \
+      }                                            \
+   } while (0)
+
+/* On the host, see tools/host, PINx is a plain variable,
+ * io_pin_write() does what the AVR does on a PINx write.
  */
 
-#define IO_ENABLE(port, out)     (port |= _BV(out))
-#define IO_DISABLE(port, out)    (port &= ~_BV(out))
-#define IO_TOGGLE(port, out)     (port ^= _BV(out))
-#define IO_IS_ENABLED(port, in)  (port && _BV(in))
+#ifdef __AVR__
+#define IO_PIN_WRITE(pin, mask)  ((pin) = (mask))
+#else
+#define IO_PIN_WRITE(pin, mask)  io_pin_write(&(pin), mask)
+#endif
+
+#define IO_TOGGLE_(port, mask)   IO_PIN_WRITE(PIN ## port, mask)
 
 #endif /* _IO_H_ */
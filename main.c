@@ -10,12 +10,23 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <util/atomic.h>
 #include <util/delay.h>
+#include "config.h"
 #include "io.h"
 #include "morse.h"
+#include "audio.h"
+#include "event.h"
+#include "voice.h"
+#include "voice_clip.h"
+#include "cor.h"
+#include "squelch.h"
+#include "tone.h"
+#include "announce.h"
 
 /* F_CPU
  * 
@@ -30,15 +41,14 @@
 
 /* TIME_ID_SEC & TIME_WAIT_ID
  * Time for ID in seconds. For 10 minutes, 60 sec/min * 10 min = 600 
- * Reaching time to id we wait TIME_WAIT_ID seconds to ID.
- * We subtract the wait time to make the "correct" time = 600 - TIME_WAIT_ID.
- * Note: This time starts counting at the end of last transmition and not
- *       from after it's tail. We can add tail time if we want to start counting
- *       after the tail or move the sentence counter_wait = 0;
+ * Reaching time to id we wait for the channel to be free for
+ * TIME_WAIT_ID seconds to ID, counted from the end of the last
+ * transmition and not from after it's tail.
+ * The next ID is due TIME_ID_SEC after this one started.
  */
 
 #define TIME_WAIT_ID    6
-#define TIME_ID_SEC     (600 - TIME_WAIT_ID)
+#define TIME_ID_SEC     600
 
 /* N_ID_FOR_MORSE
  * Number of ISD Identifications at which the morse ID 
@@ -51,6 +61,28 @@
 
 #define N_ID_FOR_MORSE  6
 
+/* BULLETIN_ENABLED, BULLETIN_SEC & BULLETIN_MSG
+ * Periodic morse bulletin, sent when the channel is free
+ * like the ID. More announcements can be added the same
+ * way, see announce.h.
+ *
+ * Default: false, every 30 minutes
+ */
+
+#define BULLETIN_ENABLED   false
+#define BULLETIN_SEC       1800
+#define BULLETIN_MSG       "QST"
+
+/* ANNOUNCE_PRIORITY_x
+ * Order of announcements due at the same time,
+ * lower first.
+ */
+
+#define ANNOUNCE_PRIORITY_TOT       0
+#define ANNOUNCE_PRIORITY_ID        1
+#define ANNOUNCE_PRIORITY_MORSE_ID  2
+#define ANNOUNCE_PRIORITY_BULLETIN  3
+
 /* MORSE_ID_x
  * Set of strings used for morse code regarding this repeater
  */
@@ -74,6 +106,44 @@
 
 #define TIME_TOT_SEC    182
 
+/* COR_ATTACK_MS, COR_RELEASE_MS & COR_KERCHUNK_MS
+ * COR glitch filter. The receiver COR must be active for
+ * COR_ATTACK_MS to key up and inactive for COR_RELEASE_MS
+ * to drop, a noisy sample only delays the edge.
+ * Key ups shorter than COR_KERCHUNK_MS are kerchunks, they
+ * don't restart the TOT or the tail and get no courtesy beep.
+ *
+ * Default: 5, 20 and 500 ms
+ */
+
+#define COR_ATTACK_MS                     5
+#define COR_RELEASE_MS                    20
+#define COR_KERCHUNK_MS                   500
+
+/* SQUELCH_OPEN_LEVEL & SQUELCH_CLOSE_LEVEL
+ * Noise squelch (SQUELCH_MODE, see config.h) out of band noise
+ * levels, see squelch.h. Carrier detected below the open level
+ * and lost above the close level. Depend on the radio and
+ * its audio level, measure them with SQUELCH_CALIBRATE.
+ *
+ * Default: 360 and 750
+ */
+
+#define SQUELCH_OPEN_LEVEL                360
+#define SQUELCH_CLOSE_LEVEL               750
+
+/* SQUELCH_CALIBRATE
+ * Calibration build of the noise squelch. Never transmits,
+ * instead sends the mean squelch_level() of the last second
+ * in morse on the beep output every SQUELCH_CALIBRATE_SEC.
+ * The RX LED still shows the squelch with the levels above.
+ *
+ * Default: false
+ */
+
+#define SQUELCH_CALIBRATE                 false
+#define SQUELCH_CALIBRATE_SEC             5
+
 /* Other definitions */
 
 #define BEEP_RX_OFF_ENABLED               false
@@ -81,47 +151,144 @@
 #define DEFAULT_TX_OFF_PENALTY_MS         200
 #define DEFAULT_TAIL_DURATION_MS          1000 
 #define DEFAULT_TOT_INHIBIT_DURATION_MS   1500
-#define DEFAULT_INHIBIT_TX_DURATION_SEC   5
+#define DEFAULT_INHIBIT_TX_DURATION_SEC   5     /* TOT info period */
+
+/* TONE_FREQ_HZ, TONE_TOLERANCE_HZ & TONE_MIN_MS
+ * Tone burst access (TONE_ACCESS_ENABLED, see config.h)
+ * burst frequency, accepted deviation and minimum length.
+ *
+ * Default: 1750, 25 and 250
+ */
+
+#define TONE_FREQ_HZ                      1750
+#define TONE_TOLERANCE_HZ                 25
+#define TONE_MIN_MS                       250
+
+/* TIMER1_TICK_HZ
+ * TIMER 1 compare rate, the seconds are counted from it.
+ */
+
+#define TIMER1_TICK_HZ                    20
+#define TIMER1_TOP                        (TONE_TIMER_HZ / TIMER1_TICK_HZ - 1)
+
+#if TIMER1_TOP > 65535
+#error "TIMER 1 compare does not fit 16 bits, check F_CPU"
+#endif
 
 /* GLOBAL VARIABLES */
 
 volatile unsigned int counter_tot         = 0;
-volatile unsigned int counter_id          = 0;
+volatile unsigned int counter_seconds     = 0;
+volatile unsigned int counter_clock       = 0;
 volatile unsigned int counter_wait        = 0;
 volatile unsigned int counter_beep        = 0;
 volatile unsigned int counter_tail        = 0;
 volatile unsigned int counter_tot_inhibit = 0;
-volatile unsigned int counter_inhibit_tx  = 0;
+static unsigned char counter_ticks        = 0;
 volatile bool time_to_tot                 = false;
-volatile bool time_to_id                  = false;
 volatile bool tot_enabled                 = false;
 volatile bool rx_audio_disable            = true;
 volatile unsigned int beep_hperiod        = 4;
+volatile bool beep_enabled                = false;
 static bool beep_tot_played               = false;
-static bool tail_pending                  = false;
-static bool tot_inhibit                   = false;
+static volatile bool tail_pending         = false;
+static volatile bool tot_inhibit          = false;
+static volatile bool access_open          = false;
 static unsigned char n_id                 = 0;
 static bool tot_play_end                  = false;
+static bool tail_beep                     = false;
+static bool tot_fresh                     = false;
+static cor_t cor;
+static morse_t *morse;
+static announce_t announce_tot_info;
+static announce_t announce_tot_end;
+static announce_t announce_id;
+static announce_t announce_morse_id;
+static announce_t announce_bulletin;
+
+/* Main loop state, only updated from the event queue */
+
+static bool rx_active                     = false;
+static bool rx_keyup                      = false;
+static bool rx_qualified                  = false;
+static bool tail_end                      = false;
+static bool tot_expired                   = false;
+static bool tot_inhibit_end               = false;
+static bool channel_idle                  = false;
+static bool voice_done                    = false;
+static unsigned char events_lost          = 0;
 
 /******************************************************************************
  * TIMER ISR's
  *****************************************************************************/
 
-/* TIMER 0 OVERFLOW ISR
- * Runs at 1 us and counts 100 = 100us period.
+/* Carrier detect as set by SQUELCH_MODE */
+
+static inline bool rx_carrier(void) {
+   if (SQUELCH_MODE == SQUELCH_MODE_NOISE) return squelch_carrier();
+   if (SQUELCH_MODE == SQUELCH_MODE_BOTH) return IO_IS_ENABLED(IO_RPT_RX) && squelch_carrier();
+   return IO_IS_ENABLED(IO_RPT_RX);
+}
+
+/* TIMER 0 COMPARE A ISR
+ * Runs at 1 us and counts 100 = 100us period, CTC
+ * mode so the period does not depend on the ISRs.
  * This ISR enables/disables the RX LED and
- * also toggles the 4066 switch (RX AUDIO)
+ * also toggles the 4066 switch (RX AUDIO).
+ * It also generates the audio for morse and beeps.
+
+    ___/```\___/```\__''__|
+   |---|---|---|---|--''--|
+
+ * Counts hperiod * 100uS then toggles state
+ * This means that the period for a square wave
+ * on the output pin is:
+ *
+ * period (sec) =  2 * hperiod * 100us
+ * frequency (Hz) = 1 / ( 2 * hperiod * 100u)
+ *
+ * Example:
+ *
+ * hperiod = 4
+ * frequency = 1 / (2 * 4 * 100u) = 1 / 800u
+ *           = 0.00125 MHz = 1.25 kHz = 1250 Hz
+ *
+ * With AUDIO_DELAY_ENABLED the 4066 stays open while
+ * the COR drops, the delay line does the muting.
+ * The COR is read through the glitch filter, see cor.c.
+ * With TONE_ACCESS_ENABLED the RX audio stays muted until
+ * a tone burst opened the repeater.
  */
 
-ISR(TIMER0_OVF_vect){
-   if (IO_IS_ENABLED(PINB, IO_RPT_RX)) {
+ISR(TIMER0_COMPA_vect){
+   bool rx;
+
+   counter_clock++;
+
+   switch (cor_update(&cor, rx_carrier())) {
+      case COR_EDGE_UP:
+         event_push(EVENT_COR_UP);
+         break;
+      case COR_EDGE_DOWN:
+         event_push(EVENT_COR_DOWN);
+         break;
+      case COR_EDGE_QUALIFIED:
+         event_push(EVENT_COR_QUALIFIED);
+         break;
+      case COR_EDGE_NONE:
+         break;
+   }
+
+   rx = cor_active(&cor);
+
+   if (rx) {
       // Started Receiving a signal
       // __/```
 
-      IO_ENABLE(PORTD, IO_LED_RX);
+      IO_ENABLE(IO_LED_RX);
 
-      if (!tot_enabled && !rx_audio_disable) {
-         IO_ENABLE(PORTD, IO_RX_UNMUTE);
+      if (!tot_enabled && !rx_audio_disable && (access_open || !TONE_ACCESS_ENABLED)) {
+         IO_ENABLE(IO_RX_UNMUTE);
       }
 
       if (tot_inhibit) counter_tot_inhibit = 0;
@@ -130,104 +297,238 @@ ISR(TIMER0_OVF_vect){
       // Stopped receiving a signal
       // ```\__
 
-      IO_DISABLE(PORTD, IO_LED_RX);
+      IO_DISABLE(IO_LED_RX);
 
-      if (!tot_enabled && !rx_audio_disable) {
-         IO_DISABLE(PORTD, IO_RX_UNMUTE);
+      if (!tot_enabled && !rx_audio_disable && !AUDIO_DELAY_ENABLED) {
+         IO_DISABLE(IO_RX_UNMUTE);
       }
    }
 
-   if (tail_pending) counter_tail++;
-   if (tot_inhibit) counter_tot_inhibit++;
+   if (AUDIO_DELAY_ENABLED) {
+      audio_gate(rx && !tot_enabled && !rx_audio_disable && (access_open || !TONE_ACCESS_ENABLED));
+   }
 
-   TCNT0 = 256-100;
-}
+   if (tail_pending) {
+      counter_tail++;
+      if (counter_tail == DEFAULT_TAIL_DURATION_MS * 10) event_push(EVENT_TAIL_END);
+   }
 
-/* TIMER 1 OVERFLOW ISR
- * Runs every 1 sec and updates the counters
- * which use seconds to count.
- */
+   if (tot_inhibit) {
+      counter_tot_inhibit++;
+      if (counter_tot_inhibit == DEFAULT_TOT_INHIBIT_DURATION_MS * 10) event_push(EVENT_TOT_INHIBIT_END);
+   }
+
+   if (VOICE_ID_ENABLED) voice_tick();
 
-ISR(TIMER1_OVF_vect) {
-   if (counter_id <= TIME_ID_SEC) {
-      counter_id++;
-      if (counter_id > TIME_ID_SEC) {
-         time_to_id = true;
+   if (beep_enabled) {
+      counter_beep++;
+      if (counter_beep > beep_hperiod) {
+         IO_TOGGLE(IO_BEEP);
+         counter_beep = 0;
       }
    }
+}
+
+/* TIMER 1 COMPARE A ISR
+ * Runs every 50 ms, TIMER 1 is in CTC mode so the
+ * input capture can use the same running count.
+ * Every TIMER1_TICK_HZ ticks, 1 sec, updates the
+ * counters which use seconds to count. Pushes an
+ * event when a counter reaches its limit.
+ */
+
+ISR(TIMER1_COMPA_vect) {
+   if (TONE_ACCESS_ENABLED) tone_idle();
+
+   if (++counter_ticks < TIMER1_TICK_HZ) return;
+   counter_ticks = 0;
+
+   counter_seconds++;
 
    if (counter_tot <= TIME_TOT_SEC) {
       counter_tot++;
+      if (counter_tot > TIME_TOT_SEC) event_push(EVENT_TOT_EXPIRED);
    }
 
-   if (time_to_id && counter_wait <= TIME_WAIT_ID) {
+   if (counter_wait <= TIME_WAIT_ID) {
       counter_wait++;
+      if (counter_wait > TIME_WAIT_ID) event_push(EVENT_CHANNEL_IDLE);
    }
+}
 
-   if (tot_inhibit) counter_inhibit_tx++;
+/******************************************************************************
+ * DELAY FUNCTIONS - BLOCKING delays on the TIMER 0 tick
+ *****************************************************************************/
 
-   TCNT1  = 65536 - (F_CPU/1024);
-}
+/* The ISRs take a good share of every 100us tick, a
+ * busy loop like _delay_ms() would stretch by that share.
+ * Counting ticks does not. Before interrupts are on
+ * (boot) there are no ticks, so the busy loop is used.
+ */
 
-/* TIMER 2 OVERFLOW ISR
- * Runs at 1uS and counts 100 = 100us.
- * Being used for audio generation, morse and beeps
+static unsigned int clock_now(void) {
+   unsigned int now = 0;
 
-    ___/```\___/```\__''__|
-   |---|---|---|---|--''--|
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      now = counter_clock;
+   }
 
- * Timer counts hperiod * 100uS then toggles state
- * This means that the period for a square wave
- * on the output pin is:
- *
- * period (sec) =  2 * hperiod * 100us
- * frequency (Hz) = 1 / ( 2 * hperiod * 100u)
- *
- * Example:
- *
- * hperiod = 4
- * frequency = 1 / (2 * 4 * 100u) = 1 / 800u
- *           = 0.00125 MHz = 1.25 kHz = 1250 Hz
- */
+   return now;
+}
+
+void delay_ms(unsigned int ms) {
+   unsigned int start;
 
+   if (!(SREG & _BV(SREG_I))) {
+      for (unsigned int c = 0; c < ms; c++) {
+         _delay_ms(1);
+      }
+      return;
+   }
 
-ISR(TIMER2_OVF_vect) {
-   counter_beep++;
-   if (counter_beep > beep_hperiod) {
-      IO_TOGGLE(PORTC, IO_BEEP);
-      counter_beep = 0;
+   start = clock_now();
+   while (ms > 0) {
+      while ((unsigned int) (clock_now() - start) < 10);
+      start += 10;
+      ms--;
+   }
+}
+
+void delay_sec(unsigned int sec) {
+   for (unsigned int c = 0; c < sec; c++) {
+      delay_ms(1000);
    }
-   TCNT2 = 256-100;
 }
 
+
 /******************************************************************************
- * DELAY FUNCTIONS - BLOCKING delays based on avr _delay_ms 
+ * EVENTS - ISR to main loop
  *****************************************************************************/
 
-void delay_sec(unsigned int sec) {
-   if (sec > 0 && sec <= 65535) {
-      for (int c = 0; c <= sec; c++) {
-         _delay_ms(1000);
-      }
+/* Counters are 16 bits and owned by the ISRs.
+ * The main loop only resets them, and reads them
+ * to confirm an event, always with interrupts off.
+ */
+
+static void counter_reset(volatile unsigned int *counter) {
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      *counter = 0;
    }
 }
 
-void delay_ms(unsigned int ms) {
-   if (ms > 0 && ms <= 65535) {
-      for (int c = 0; c <= ms; c++) {
-         _delay_ms(1);
-      }
+static bool counter_reached(volatile unsigned int *counter, unsigned int value) {
+   unsigned int count = 0;
+
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      count = *counter;
    }
+
+   return count >= value;
 }
 
+/* Each reset clears the flag set by the matching event.
+ * An event queued before the reset is then dropped by
+ * the counter_reached check in events_dispatch.
+ */
 
-/*
-void change_status(repeater_status_t status) {
-   ATOMIC_BLOCK(ATOMIC_FORCEON) {
-      repeater_status = status;
+static void tot_restart(void) {
+   counter_reset(&counter_tot);
+   tot_expired = false;
+}
+
+static void tail_restart(void) {
+   counter_reset(&counter_tail);
+   tail_end = false;
+}
+
+static void tot_inhibit_restart(void) {
+   counter_reset(&counter_tot_inhibit);
+   tot_inhibit_end = false;
+}
+
+static void channel_idle_restart(void) {
+   counter_reset(&counter_wait);
+   channel_idle = false;
+}
+
+/* Seconds since boot, wraps. Scheduler time base. */
+
+static unsigned int seconds_now(void) {
+   unsigned int now = 0;
+
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      now = counter_seconds;
+   }
+
+   return now;
+}
+
+/* Rebuilds the main loop state from the pin and the
+ * counters, used when the queue overflowed.
+ */
+
+static void events_resync(void) {
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      rx_active = cor_active(&cor);
+      rx_qualified = cor_qualified(&cor);
+   }
+   if (rx_active) rx_keyup = true;
+   tail_end = tail_pending && counter_reached(&counter_tail, DEFAULT_TAIL_DURATION_MS * 10);
+   tot_expired = counter_reached(&counter_tot, TIME_TOT_SEC + 1);
+   tot_inhibit_end = tot_inhibit && counter_reached(&counter_tot_inhibit, DEFAULT_TOT_INHIBIT_DURATION_MS * 10);
+   channel_idle = counter_reached(&counter_wait, TIME_WAIT_ID + 1);
+   voice_done = !VOICE_ID_ENABLED || !voice_playing();
+}
+
+/* Drains the queue in batch. COR up latches rx_keyup,
+ * so a short blip is still seen by the main loop.
+ */
+
+static void events_dispatch(void) {
+   event_t event;
+
+   while (event_pop(&event)) {
+      switch (event.type) {
+         case EVENT_COR_UP:
+            rx_active = true;
+            rx_keyup = true;
+            rx_qualified = false;
+            break;
+         case EVENT_COR_QUALIFIED:
+            rx_qualified = true;
+            break;
+         case EVENT_COR_DOWN:
+            rx_active = false;
+            break;
+         case EVENT_TAIL_END:
+            tail_end = counter_reached(&counter_tail, DEFAULT_TAIL_DURATION_MS * 10);
+            break;
+         case EVENT_TOT_EXPIRED:
+            tot_expired = counter_reached(&counter_tot, TIME_TOT_SEC + 1);
+            break;
+         case EVENT_TOT_INHIBIT_END:
+            tot_inhibit_end = counter_reached(&counter_tot_inhibit, DEFAULT_TOT_INHIBIT_DURATION_MS * 10);
+            break;
+         case EVENT_CHANNEL_IDLE:
+            channel_idle = counter_reached(&counter_wait, TIME_WAIT_ID + 1);
+            break;
+         case EVENT_VOICE_DONE:
+            voice_done = true;
+            break;
+         case EVENT_TONE_BURST:
+            if (rx_active) {
+               access_open = true;
+               rx_keyup = true;
+            }
+            break;
+      }
+   }
+
+   if (event_overflows() != events_lost) {
+      events_lost = event_overflows();
+      events_resync();
    }
 }
-*/
 
 
 /******************************************************************************
@@ -236,9 +537,9 @@ void change_status(repeater_status_t status) {
 
 void beep(unsigned char hperiod, unsigned int duration) {
    beep_hperiod = hperiod;
-   TCCR2B = (1 << CS21); //Set Prescaler to 8 (bit 11 => 1 MHz) and start timer
+   beep_enabled = true;
    delay_ms(duration);
-   TCCR2B = 0;
+   beep_enabled = false;
 }
 
 void beep_morse(unsigned int duration) {
@@ -288,11 +589,11 @@ void beep_on_boot(void) {
 void intro_sequence(void) {
    PORTD = 0x0;
    delay_ms(500);
-   IO_ENABLE(PORTD, IO_LED_RX);
+   IO_ENABLE(IO_LED_RX);
    delay_ms(500);
-   IO_ENABLE(PORTD, IO_LED_TX);
+   IO_ENABLE(IO_LED_TX);
    delay_ms(500);
-   IO_ENABLE(PORTD, IO_LED_TOT);
+   IO_ENABLE(IO_LED_TOT);
    delay_ms(2500);
    PORTD = 0x0;
 }
@@ -301,15 +602,19 @@ void intro_sequence(void) {
 
 void setup_io(void) {
    /* PORTB
-    * All ports as outputs excep IO_RPT_RX
+    * All ports as outputs excep IO_RPT_RX, and IO_TONE_IN
+    * so the comparator is not shorted during the intro
     */
    DDRB = 0xFF;
-   DDRB &= ~_BV(DDB5);
+   IO_INPUT(IO_RPT_RX);
+   if (TONE_ACCESS_ENABLED) IO_INPUT(IO_TONE_IN);
 
    /* PORTC
-    * All ports as outputs and init out values
+    * All ports as outputs and init out values, but
+    * IO_RX_AUDIO when the ADC reads it
     */
    DDRC  = 0x7F;
+   if (AUDIO_DELAY_ENABLED || SQUELCH_MODE != SQUELCH_MODE_COR) IO_INPUT(IO_RX_AUDIO);
 
    /* PORTD
     * All ports as outputs and init out values
@@ -322,6 +627,119 @@ void setup_io(void) {
    PORTD = 0x0;
 }
 
+/******************************************************************************
+ * ANNOUNCEMENTS - played by the scheduler, see announce.h
+ *****************************************************************************/
+
+static void announce_morse(const void *msg) {
+   delay_ms(200);
+   morse_send_msg(morse, (char *) msg);
+   delay_ms(200);
+}
+
+/* TOT info, the "K" is only sent if it played */
+
+static void announce_tot(const void *msg) {
+   announce_morse(msg);
+   tot_play_end = true;
+}
+
+/* Voice ID, from flash or the ISD board. Every
+ * N_ID_FOR_MORSE IDs the morse ID follows along.
+ */
+
+static void announce_voice_id(const void *arg) {
+   if (VOICE_ID_ENABLED) {
+      if (AUDIO_DELAY_ENABLED) IO_ENABLE(IO_RX_UNMUTE);
+      voice_done = false;
+      voice_play(voice_clip, voice_clip_samples);
+
+      while (!voice_done) {
+         IO_ENABLE(IO_LED_TX);
+         delay_ms(250);
+         IO_DISABLE(IO_LED_TX);
+         delay_ms(250);
+         events_dispatch();
+      }
+
+      if (AUDIO_DELAY_ENABLED) IO_DISABLE(IO_RX_UNMUTE);
+   } else {
+      IO_ENABLE(IO_ISD_PLAY);
+
+      for (int c=0; c<21; c++) {
+         IO_ENABLE(IO_LED_TX);
+         delay_ms(250); 
+         IO_DISABLE(IO_LED_TX);
+         delay_ms(250);
+      }
+
+      IO_DISABLE(IO_ISD_PLAY);
+   }
+
+   IO_ENABLE(IO_LED_TX);
+
+   n_id++;
+
+   if (n_id >= N_ID_FOR_MORSE) {
+      announce_schedule(&announce_morse_id, seconds_now(), 0);
+      n_id = 0;
+   }
+}
+
+/* Keys up once and plays every due announcement.
+ * Idle only ones just when the channel has been free
+ * for TIME_WAIT_ID. Stays keyed if someone keyed up
+ * meanwhile, unless in TOT.
+ */
+
+static bool announcements_run(bool idle) {
+   announce_t *announce = announce_next(seconds_now(), idle);
+
+   if (announce == NULL) return false;
+
+   rx_audio_disable = true;
+   IO_ENABLE(IO_TX);
+
+   do {
+      announce->play(announce->arg);
+   } while ((announce = announce_next(seconds_now(), idle)) != NULL);
+
+   events_dispatch();
+
+   if (tot_enabled || !rx_active) {
+      IO_DISABLE(IO_TX);
+      delay_ms(DEFAULT_TX_OFF_PENALTY_MS);
+   } else {
+      IO_ENABLE(IO_LED_TX);
+   }
+
+   channel_idle_restart();
+   rx_audio_disable = false;
+
+   return true;
+}
+
+/******************************************************************************
+ * SQUELCH CALIBRATION - see SQUELCH_CALIBRATE
+ *****************************************************************************/
+
+static void squelch_calibrate(void) {
+   char msg[6];
+
+   while (true) {
+      unsigned long sum = 0;
+
+      for (int n = 0; n < 100; n++) {
+         sum += squelch_level();
+         delay_ms(10);
+      }
+
+      utoa(sum / 100, msg, 10);
+      morse_send_msg(morse, msg);
+      delay_sec(SQUELCH_CALIBRATE_SEC - 1);
+   }
+}
+
 /******************************************************************************
  * APPLICATION ENTRY POINT 
  *****************************************************************************/
@@ -331,61 +749,97 @@ int main(void) {
    setup_io();
    intro_sequence();
 
+   /* COR filter, in TIMER 0 ticks of 100us */
+   cor_init(&cor, COR_ATTACK_MS * 10, COR_RELEASE_MS * 10, COR_KERCHUNK_MS * 10);
+
    /* Morse generator init */
-   morse_t *morse = morse_new();
+   morse = morse_new();
    morse_speed_set(morse, MORSE_WPM);
    morse_beep_delegate_connect(morse, beep_morse);
    morse_delay_delegate_connect(morse, delay_ms);
 
+   /* Announcements, in seconds from boot */
+   announce_init(&announce_tot_info, announce_tot, MORSE_TOT_INFO, DEFAULT_INHIBIT_TX_DURATION_SEC, ANNOUNCE_PRIORITY_TOT, false);
+   announce_init(&announce_tot_end, announce_morse, MORSE_TOT_END, 0, ANNOUNCE_PRIORITY_TOT, false);
+   announce_init(&announce_id, announce_voice_id, NULL, TIME_ID_SEC, ANNOUNCE_PRIORITY_ID, true);
+   announce_init(&announce_morse_id, announce_morse, MORSE_ID, 0, ANNOUNCE_PRIORITY_MORSE_ID, true);
+   announce_init(&announce_bulletin, announce_morse, BULLETIN_MSG, BULLETIN_SEC, ANNOUNCE_PRIORITY_BULLETIN, true);
+
+   announce_schedule(&announce_id, 0, TIME_ID_SEC);
+
+   if (BULLETIN_ENABLED) {
+      announce_schedule(&announce_bulletin, 0, BULLETIN_SEC);
+   }
+
    /* TIMER 0
     *
     * Set Timer to 100usec. With XTAL 8MHz / 8 = 1MHz.
     * Prescaler set to 8 we get 1MHZ which equals 1usec.
-    * Count 100 times and we have 100usec
+    * CTC mode, count 0 to 99 (OCR0A) and we have 100usec
     * TCCR0B = (1 << CS01) sets the Prescaler to 8 (bit 11)
     * and starts the timer
     */
 
-   TCNT0  = 256-100;
-   TIMSK0 = (1 << TOIE0); 
-   TCCR0A = 0x00;
+   TCNT0  = 0;
+   OCR0A  = 100 - 1;
+   TIMSK0 = (1 << OCIE0A);
+   TCCR0A = (1 << WGM01);
    TCCR0B = (1 << CS01);
 
    /* TIMER 1
     *
-    * We will use this timer as a 1 second clock. Prescaler at 1024
-    * and count MAX_INT - (8MHz/1024).
-    * TCCR1B = (1 << CS10) | (1 << CS12); sets the prescaler to 1024
-    * (bit 10 and 12) and starts the timer
+    * We will use this timer as a 1 second clock. Prescaler at 8,
+    * 1MHz at 8MHz, CTC on OCR1A every 50ms (50000 counts) and
+    * the ISR counts 20 of those. The fine count is also the
+    * time base for the tone burst input capture.
+    * TCCR1B = (1 << WGM12) | (1 << CS11); CTC mode, prescaler 8
+    * and starts the timer
     */
 
-   TCNT1  = 65535 - (F_CPU/1024);
-   TIMSK1 = (1 << TOIE1); 
+   TCNT1  = 0;
+   OCR1A  = TIMER1_TOP;
+   TIMSK1 = (1 << OCIE1A);
    TCCR1A = 0x00;
-   TCCR1B = (1 << CS10) | (1 << CS12); //Set Prescaler to 1024 (bit 10 and 12) and start timer
+   TCCR1B = (1 << WGM12) | (1 << CS11);
+
+   if (TONE_ACCESS_ENABLED) {
+      tone_init(TIMER1_TOP + 1, TONE_FREQ_HZ, TONE_TOLERANCE_HZ, TONE_MIN_MS);
+   }
 
    /* TIMER 2
     *
-    * Sets the timer to 1usec as timer 0. But we use it as needed
-    * and control the timer with TCCR2B. This timer with the ISR will
-    * generate the beeps being used in the repeater.
-    * Count 100 and we have 100usec as reference. The ISR will toggle
-    * the output pin.
-    *
+    * Free for the PWM DAC. The beeps are generated by the
+    * TIMER 0 ISR, on the same 100usec reference.
+    * The ADC is triggered by TIMER 0 compare match A.
     */
 
-   TCNT2  = 256-100;
-   TIMSK2 = (1 << TOIE2); 
-   TCCR2A = 0x00;
-   TCCR2B = 0;
+   if (AUDIO_DELAY_ENABLED || VOICE_ID_ENABLED) {
+      audio_dac_init();
+   }
+
+   if (AUDIO_DELAY_ENABLED || SQUELCH_MODE != SQUELCH_MODE_COR) {
+      audio_adc_init();
+   }
+
+   if (AUDIO_DELAY_ENABLED) {
+      audio_delay_init(COR_RELEASE_MS);
+   }
+
+   if (SQUELCH_MODE != SQUELCH_MODE_COR) {
+      squelch_init(SQUELCH_OPEN_LEVEL, SQUELCH_CLOSE_LEVEL);
+   }
 
 
    /* Turn interrupts on */ 
    sei();
 
+   /* Calibration build, RX audio stays muted */
+   if (SQUELCH_CALIBRATE && SQUELCH_MODE != SQUELCH_MODE_COR) {
+      squelch_calibrate();
+   }
+
    /* On boot beeping */
-   IO_ENABLE(PORTD, IO_LED_TX);
-   IO_ENABLE(PORTD, IO_PTT);
+   IO_ENABLE(IO_TX);
 
    delay_ms(500);
    beep_on_boot();
@@ -393,79 +847,91 @@ int main(void) {
    morse_send_msg(morse, MORSE_RPT_START);
    delay_ms(500);
 
-   IO_DISABLE(PORTD, IO_LED_TX);
-   IO_DISABLE(PORTD, IO_PTT);
+   IO_DISABLE(IO_TX);
 
    delay_ms(500);
 
    /* Enable the rx audio now - disabled in declaration */
    rx_audio_disable = false;
 
-   /* Superloop */
+   /* Superloop
+    * Conditions come from the event queue, see events_dispatch()
+    */
 
    while(true) {
 
-      if (IO_IS_ENABLED(PINB, IO_RPT_RX)) {
-         IO_ENABLE(PORTD, IO_LED_TX);
-         IO_ENABLE(PORTD, IO_PTT);
-         if (!tail_pending) {
-            counter_tot = 0;
-         }
+      events_dispatch();
+
+      /* Repeater down and no tone burst yet, not a key up.
+       * The channel is still busy, the ID waits until the
+       * carrier has been gone for TIME_WAIT_ID.
+       */
+      if (TONE_ACCESS_ENABLED && !access_open) {
+         if (rx_keyup || rx_active) channel_idle_restart();
+         rx_keyup = false;
+      }
+
+      if (rx_keyup) {
+         /* A new over restarts the TOT once it is not a kerchunk.
+          * After a kerchunk the TOT restart waits for the next key up.
+          */
+         bool tail_was_pending = tail_pending;
+
+         if (!tail_pending) tot_fresh = true;
+         rx_keyup = false;
+         IO_ENABLE(IO_TX);
 
          beep_tot_played = false;
 
-         while (IO_IS_ENABLED(PINB, IO_RPT_RX) && !tot_enabled) {
-            asm("");
+         while (rx_active && !tot_enabled) {
+            events_dispatch();
+
+            if (tot_fresh && rx_qualified) {
+               tot_restart();
+               tot_fresh = false;
+            }
             
-            if (counter_tot > TIME_TOT_SEC && !beep_tot_played) {
+            if (tot_expired && !beep_tot_played && !tot_fresh) {
                tot_enabled = true;
                delay_ms(100);
-               IO_DISABLE(PORTD, IO_RX_UNMUTE);
+               IO_DISABLE(IO_RX_UNMUTE);
                beep_timeout();
                delay_ms(100);
                beep_tot_played = true;
 
-               IO_DISABLE(PORTD, IO_LED_TX);
-               IO_DISABLE(PORTD, IO_PTT);
+               IO_DISABLE(IO_TX);
             }
          }
 
          if (tot_enabled) {
-            IO_ENABLE(PORTD, IO_LED_TOT);
-            counter_inhibit_tx = 0;
+            IO_ENABLE(IO_LED_TOT);
             tot_inhibit = true;
-            counter_tot_inhibit = 0;
+            tot_inhibit_restart();
             tot_play_end = false;
+            announce_schedule(&announce_tot_info, seconds_now(), DEFAULT_INHIBIT_TX_DURATION_SEC);
 
-            while (counter_tot_inhibit < (DEFAULT_TOT_INHIBIT_DURATION_MS * 10)) {
-               if(counter_inhibit_tx >= DEFAULT_INHIBIT_TX_DURATION_SEC) {
-                  IO_ENABLE(PORTD, IO_LED_TX);
-                  IO_ENABLE(PORTD, IO_PTT);
-                  delay_ms(200);
-                  morse_send_msg(morse, MORSE_TOT_INFO);
-                  delay_ms(200);
-                  IO_DISABLE(PORTD, IO_LED_TX);
-                  IO_DISABLE(PORTD, IO_PTT);
-                  counter_inhibit_tx = 0;
-                  tot_play_end = true;
-               }
+            while (!tot_inhibit_end) {
+               events_dispatch();
+               announcements_run(false);
             }
 
+            announce_cancel(&announce_tot_info);
 
             if (tot_play_end) {
-               IO_ENABLE(PORTD, IO_LED_TX);
-               IO_ENABLE(PORTD, IO_PTT);
-               delay_ms(200);
-               morse_send_msg(morse, MORSE_TOT_END);
-               delay_ms(200);
-               IO_DISABLE(PORTD, IO_LED_TX);
-               IO_DISABLE(PORTD, IO_PTT);
+               announce_schedule(&announce_tot_end, seconds_now(), 0);
+               announcements_run(false);
             }
 
+            /* Key ups during the penalty only restarted it,
+             * the COR is down by now. Not a new over.
+             */
             tot_inhibit = false;
             tot_enabled = false; 
             tail_pending = false;
-            IO_DISABLE(PORTD, IO_LED_TOT);
+            access_open = false;
+            rx_keyup = false;
+            rx_qualified = false;
+            IO_DISABLE(IO_LED_TOT);
          } else {
             // Normal tail ending. Add some time and beep
             tail_pending = true;
@@ -475,70 +941,54 @@ int main(void) {
             }
          }
 
-         counter_tail = 0;
-         counter_wait = 0;
-         counter_tot_inhibit = 0;
+         if (tot_fresh && rx_qualified) {
+            tot_restart();
+            tot_fresh = false;
+         }
+
+         /* A kerchunk does not extend a running tail and
+          * a tail started by a kerchunk ends without beep
+          */
+
+         if (rx_qualified) {
+            tail_beep = true;
+         } else if (!tail_was_pending) {
+            tail_beep = false;
+         }
+
+         if (rx_qualified || !tail_was_pending) {
+            tail_restart();
+         }
+
+         channel_idle_restart();
+         tot_inhibit_restart();
       }
 
-      if (counter_tail >= (DEFAULT_TAIL_DURATION_MS * 10) && tail_pending && !IO_IS_ENABLED(PINB, IO_RPT_RX)) {
+      if (tail_end && tail_pending && !rx_active) {
 
          rx_audio_disable = true;
-         if (time_to_id) { 
-            beep_tail_id();
-         } else {
-            beep_tail_normal();
+         if (tail_beep) {
+            if (announce_pending(&announce_id, seconds_now())) {
+               beep_tail_id();
+            } else {
+               beep_tail_normal();
+            }
          }
 
-         IO_DISABLE(PORTD, IO_LED_TX);
-         IO_DISABLE(PORTD, IO_PTT);
+         IO_DISABLE(IO_TX);
          delay_ms(DEFAULT_TX_OFF_PENALTY_MS);
          rx_audio_disable = false;
          tail_pending = false;
-         counter_tail = 0;
+         access_open = false;
+         tail_restart();
       }
 
-      /**
-       * It's time to ID? If so, we can count if it has
-       * been free in the last TIME_WAIT_ID seconds
+      /* Announcements. The ID and the other idle only ones
+       * wait until the channel has been free for TIME_WAIT_ID
        */
 
-      if (time_to_id && counter_wait > TIME_WAIT_ID) {
-         counter_id = 0;
-         time_to_id = false;
-         rx_audio_disable = true;
-         IO_ENABLE(PORTD, IO_PTT);
-         IO_ENABLE(PORTD, IO_ISD_PLAY);
-         
-         for (int c=0; c<21; c++) {
-            IO_ENABLE(PORTD, IO_LED_TX);
-            delay_ms(250); 
-            IO_DISABLE(PORTD, IO_LED_TX);
-            delay_ms(250);
-         }
-
-         IO_ENABLE(PORTD, IO_LED_TX);
-         IO_DISABLE(PORTD, IO_ISD_PLAY);
-
-         n_id++;
-
-         if (n_id >= N_ID_FOR_MORSE) {
-            IO_ENABLE(PORTD, IO_LED_TX);
-            delay_ms(100);
-            morse_send_msg(morse, MORSE_ID);
-            delay_ms(100);
-            n_id = 0;
-            IO_DISABLE(PORTD, IO_LED_TX);
-         }
-         
-         if (!IO_IS_ENABLED(PINB, IO_RPT_RX)) {
-            IO_DISABLE(PORTD, IO_LED_TX);
-            IO_DISABLE(PORTD, IO_PTT);
-            delay_ms(DEFAULT_TX_OFF_PENALTY_MS);
-         } else {
-            IO_ENABLE(PORTD, IO_LED_TX);
-         }
-         counter_wait = 0;
-         rx_audio_disable = false;
+      if (!rx_active && !tail_pending) {
+         announcements_run(channel_idle);
       }
    }
 }
@@ -27,6 +27,26 @@
 #define DOTLEN          (1200/CW_SPEED)
 #define DASHLEN         (WEIGHT * DOTLEN)
 
+/* MORSE_BEEP_DELEGATE & MORSE_DELAY_DELEGATE
+ * Optional compile time delegates, e.g. -DMORSE_BEEP_DELEGATE=beep_morse
+ * When defined, the function is called directly instead of through
+ * the connected pointer, so LTO can inline it. Used by make release.
+ */
+
+#ifdef MORSE_BEEP_DELEGATE
+void MORSE_BEEP_DELEGATE(unsigned int duration);
+#define BEEP(morse, duration)    MORSE_BEEP_DELEGATE(duration)
+#else
+#define BEEP(morse, duration)    (morse)->beep_delegate(duration)
+#endif
+
+#ifdef MORSE_DELAY_DELEGATE
+void MORSE_DELAY_DELEGATE(unsigned int duration);
+#define DELAY(morse, duration)   MORSE_DELAY_DELEGATE(duration)
+#else
+#define DELAY(morse, duration)   (morse)->delay_delegate(duration)
+#endif
+
 struct _morse_t {
    unsigned char speed;
    float weight;
@@ -89,14 +109,14 @@ struct t_mtab morsetab[] = {
 
 static void dash(morse_t *morse) {
    assert(morse != NULL);
-   morse->beep_delegate(morse->length_dash);
-   morse->delay_delegate(morse->length_dot);
+   BEEP(morse, morse->length_dash);
+   DELAY(morse, morse->length_dot);
 }
 
 static void dit(morse_t *morse) {
    assert(morse != NULL);
-   morse->beep_delegate(morse->length_dot);
-   morse->delay_delegate(morse->length_dot);
+   BEEP(morse, morse->length_dot);
+   DELAY(morse, morse->length_dot);
 }
 
 static void send(morse_t *morse, char c) {
@@ -104,18 +124,18 @@ static void send(morse_t *morse, char c) {
    
    int i ;
    if (c == ' ') {
-      morse->delay_delegate(7 * morse->length_dot);
+      DELAY(morse, 7 * morse->length_dot);
       return ;
    }
    
    if (c == '+') {
-      morse->delay_delegate(4 * morse->length_dot);
+      DELAY(morse, 4 * morse->length_dot);
       dit(morse);
       dash(morse);
       dit(morse);
       dash(morse);
       dit(morse);
-      morse->delay_delegate(4 * morse->length_dot);
+      DELAY(morse, 4 * morse->length_dot);
       return ;
    }    
     
@@ -129,7 +149,7 @@ static void send(morse_t *morse, char c) {
                dit(morse);
             p = p / 2 ;
          }
-         morse->delay_delegate(2 * morse->length_dot);
+         DELAY(morse, 2 * morse->length_dot);
          return ;
       }
    }
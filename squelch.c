@@ -0,0 +1,132 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * squelch.c
+ *
+ * Squelch implementation file
+ *
+ * High pass: three second order sections with their zeros
+ * on the unit circle, all coefficients 0, +/-1 or -2:
+ *    1 - 2z^-1 + z^-2   double zero at DC
+ *    1 -  z^-1 + z^-2   zero at fs/6, 1667 Hz
+ *    1        + z^-2   zero at fs/4, 2500 Hz
+ * output scaled down by 4. |H(f)| at fs = 10 kHz is 0.02
+ * at 300 Hz, 0.1 at 1 kHz, 0.02 at 1750 Hz, 0 at 2.5 kHz,
+ * 0.66 at 3 kHz, 2 at 3.5 kHz and 6 at 5 kHz, -3 dB at
+ * ~4.1 kHz. Full deviation tones and speech up to ~2.8 kHz
+ * stay 25 dB or more under the noise, so neither voice nor
+ * the 1750 Hz burst reads as noise.
+ * Energy: leaky integrator of |y|, time constant
+ * 2^SQUELCH_SHIFT samples. Shifts and adds only.
+ * Only compiled in when SQUELCH_MODE uses it.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <util/atomic.h>
+#include "config.h"
+#include "squelch.h"
+
+#if SQUELCH_MODE != SQUELCH_MODE_COR
+
+/* SQUELCH_HP_SHIFT
+ * High pass output scaling. The sum of |coefficients| is
+ * 24, so |y| of 8 bit samples is at most 24 * 128 = 3072,
+ * 768 once scaled.
+ */
+
+#define SQUELCH_HP_SHIFT   2
+
+/* SQUELCH_SHIFT
+ * Integrator time constant, 2^6 = 64 samples = 6.4 ms.
+ * level holds mean |y| scaled by 2^SQUELCH_SHIFT, at most
+ * 768 * 64 = 49152. Levels are mean |y| * 16 so compare
+ * against level >> (SQUELCH_SHIFT - 4).
+ */
+
+#define SQUELCH_SHIFT   6
+#define SQUELCH_SCALE   (SQUELCH_SHIFT - 4)
+
+static bool enabled                    = false;
+static int8_t x1                       = 0;
+static int8_t x2                       = 0;
+static int16_t d1                      = 0;
+static int16_t d2                      = 0;
+static int16_t s1                      = 0;
+static int16_t s2                      = 0;
+static uint16_t level                  = 0;
+static uint16_t level_open             = 0;
+static uint16_t level_close            = 0;
+static volatile bool carrier           = false;
+
+/* Public */
+
+/* squelch_init
+ * Starts the detector, the ADC must be running,
+ * see audio_adc_init(). Starts with no carrier
+ * and the integrator full of noise.
+ */
+
+void squelch_init(unsigned int open, unsigned int close) {
+   x1 = x2 = 0;
+   d1 = d2 = 0;
+   s1 = s2 = 0;
+   level_open = open;
+   level_close = close;
+   level = close << SQUELCH_SCALE;
+   carrier = false;
+   enabled = true;
+}
+
+/* squelch_sample
+ * Called from the ADC ISR with every sample.
+ */
+
+void squelch_sample(int8_t sample) {
+   int16_t d, s, y;
+
+   if (!enabled) return;
+
+   d = (int16_t) sample - 2 * x1 + x2;
+   x2 = x1;
+   x1 = sample;
+   s = d - d1 + d2;
+   d2 = d1;
+   d1 = d;
+   y = s + s2;
+   s2 = s1;
+   s1 = s;
+   if (y < 0) y = -y;
+   y >>= SQUELCH_HP_SHIFT;
+
+   level -= level >> SQUELCH_SHIFT;
+   level += y;
+
+   if (carrier) {
+      if ((level >> SQUELCH_SCALE) > level_close) carrier = false;
+   } else {
+      if ((level >> SQUELCH_SCALE) < level_open) carrier = true;
+   }
+}
+
+bool squelch_carrier(void) {
+   return carrier;
+}
+
+/* squelch_level
+ * Current noise level, for calibration.
+ */
+
+unsigned int squelch_level(void) {
+   unsigned int value = 0;
+
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      value = level >> SQUELCH_SCALE;
+   }
+
+   return value;
+}
+
+#endif
@@ -0,0 +1,33 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * squelch.h
+ *
+ * Squelch Header file
+ *
+ * Noise squelch for receivers without a usable COR.
+ * Measures the out of band (above ~3 kHz) noise in the
+ * unsquelched RX audio. An FM receiver without carrier
+ * is all noise up there, a carrier quiets it.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _SQUELCH_H_
+#define _SQUELCH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Levels are the mean of |high pass output| in ADC LSB,
+ * times 16, see squelch.c for the high pass. Carrier is
+ * detected below the open level and lost above the close
+ * level, close > open.
+ */
+
+void                             squelch_init(unsigned int open, unsigned int close);
+void                             squelch_sample(int8_t sample);
+bool                             squelch_carrier(void);
+unsigned int                     squelch_level(void);
+
+#endif /* _SQUELCH_H_ */
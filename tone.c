@@ -0,0 +1,144 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * tone.c
+ *
+ * Tone implementation file
+ *
+ * Edges are grouped in blocks of TONE_CYCLES periods
+ * and the block span is checked against the window for
+ * freq +/- tolerance. Averaging over a few periods
+ * makes the window tight and noise edges fail it.
+ * Good blocks count up, bad blocks count down harder,
+ * reaching the duration count means a tone burst.
+ *
+ * The capture time wraps every 50 ms, so the span alone
+ * cannot tell 9.1 ms from 59.1 ms (16 periods of 270.5 Hz)
+ * or 109.1 ms (146.6 Hz). tone_idle() counts the wraps
+ * inside the block and any block over one wrap, or one
+ * wrap without the time going round, is a bad block.
+ * Only compiled in with TONE_ACCESS_ENABLED.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "config.h"
+#include "io.h"
+#include "event.h"
+#include "tone.h"
+
+#if TONE_ACCESS_ENABLED
+
+/* TONE_CYCLES & TONE_PENALTY
+ * Periods per block, 16 = ~9.1 ms at 1750 Hz.
+ * Count lost per bad block.
+ */
+
+#define TONE_CYCLES     16
+#define TONE_PENALTY    2
+
+static unsigned int wrap_ticks         = 0;
+static unsigned int span_min           = 0;
+static unsigned int span_max           = 0;
+static unsigned int blocks_needed      = 1;
+static unsigned int blocks             = 0;
+static unsigned int block_start        = 0;
+static unsigned char cycles            = 0;
+static unsigned char wraps             = 0;
+static bool running                    = false;
+static bool captured                   = false;
+static volatile bool detected          = false;
+
+/******************************************************************************
+ * TIMER 1 CAPTURE ISR
+ *****************************************************************************/
+
+ISR(TIMER1_CAPT_vect) {
+   tone_capture(ICR1);
+}
+
+/******************************************************************************
+ * PUBLIC
+ *****************************************************************************/
+
+/* tone_init
+ * wrap is the TIMER 1 period (TOP + 1), the capture time
+ * wraps there. Looks for freq +/- tolerance Hz lasting
+ * duration_ms. Sets up ICP1 (PB0) as input, rising edge,
+ * with the noise canceler. TIMER 1 must be running with
+ * TONE_TIMER_PRESCALER.
+ */
+
+void tone_init(unsigned int wrap, unsigned int freq, unsigned int tolerance, unsigned int duration_ms) {
+   wrap_ticks = wrap;
+   span_min = (unsigned long) TONE_TIMER_HZ * TONE_CYCLES / (freq + tolerance);
+   span_max = (unsigned long) TONE_TIMER_HZ * TONE_CYCLES / (freq - tolerance);
+   blocks_needed = (unsigned long) duration_ms * freq / (1000UL * TONE_CYCLES);
+   if (blocks_needed == 0) blocks_needed = 1;
+
+   IO_INPUT(IO_TONE_IN);
+   TCCR1B |= (1 << ICNC1) | (1 << ICES1);
+   TIMSK1 |= (1 << ICIE1);
+}
+
+/* tone_capture
+ * Called with the capture time of every rising edge.
+ */
+
+void tone_capture(unsigned int time) {
+   unsigned int span;
+   bool wrapped;
+
+   captured = true;
+
+   if (!running) {
+      running = true;
+      block_start = time;
+      cycles = 0;
+      wraps = 0;
+      return;
+   }
+
+   if (++cycles < TONE_CYCLES) return;
+
+   span = time >= block_start ? time - block_start : time + wrap_ticks - block_start;
+   wrapped = wraps > 1 || (wraps == 1 && time >= block_start);
+   block_start = time;
+   cycles = 0;
+   wraps = 0;
+
+   if (!wrapped && span >= span_min && span <= span_max) {
+      if (blocks < blocks_needed) blocks++;
+      if (blocks == blocks_needed && !detected) {
+         detected = true;
+         event_push(EVENT_TONE_BURST);
+      }
+   } else {
+      blocks = blocks > TONE_PENALTY ? blocks - TONE_PENALTY : 0;
+      if (blocks == 0) detected = false;
+   }
+}
+
+/* tone_idle
+ * Called from the TIMER 1 ISR every 50 ms, at the wrap.
+ * No edge since the last call means no tone.
+ */
+
+void tone_idle(void) {
+   if (wraps < 2) wraps++;
+   if (!captured) {
+      running = false;
+      blocks = 0;
+      detected = false;
+   }
+   captured = false;
+}
+
+bool tone_detected(void) {
+   return detected;
+}
+
+#endif
@@ -0,0 +1,33 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * tone.h
+ *
+ * Tone Header file
+ *
+ * Tone burst (1750 Hz) detector. The limited RX audio
+ * goes into ICP1 (PB0) and TIMER 1 input capture times
+ * the rising edges. No DSP, just period measurement.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _TONE_H_
+#define _TONE_H_
+
+#include <stdbool.h>
+
+/* TONE_TIMER_HZ
+ * TIMER 1 clock, prescaler 8. 1 MHz at 8MHz,
+ * so a 1750 Hz period is ~571 ticks.
+ */
+
+#define TONE_TIMER_PRESCALER  8
+#define TONE_TIMER_HZ         (F_CPU / TONE_TIMER_PRESCALER)
+
+void                             tone_init(unsigned int wrap, unsigned int freq, unsigned int tolerance, unsigned int duration_ms);
+void                             tone_capture(unsigned int time);
+void                             tone_idle(void);
+bool                             tone_detected(void);
+
+#endif /* _TONE_H_ */
@@ -0,0 +1,75 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * adpcm_snr.c
+ *
+ * Host test of the ADPCM codec, as used by the delay
+ * line (10 kHz) and the voice ID (5 kHz). A 1 kHz +
+ * 300 Hz tone pair, quantized to 8 bits like the ADC,
+ * goes through encode and decode and the SNR of the
+ * decoded audio is checked at a few levels.
+ *
+ * adpcm_snr    exits 1 if any case is under its limit
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "../adpcm.h"
+
+#define SETTLE_SAMPLES  100
+
+typedef struct _snr_case_t {
+   unsigned int rate;
+   double level_db;        /* Peak, dB below ADC full scale */
+   double limit_db;        /* Minimum SNR, ~2 dB under the measured */
+} snr_case_t;
+
+static const snr_case_t cases[] = {
+   { 10000,  -1.0, 22.0 },
+   { 10000,  -6.0, 22.0 },
+   { 10000, -20.0, 22.0 },
+   {  5000,  -1.0, 16.0 },
+   {  5000,  -6.0, 16.0 },
+};
+
+static double snr_db(unsigned int rate, double level_db) {
+   double peak = 127.0 * pow(10.0, level_db / 20.0);
+   double signal = 0, noise = 0;
+   adpcm_t encoder;
+   adpcm_t decoder;
+
+   adpcm_init(&encoder);
+   adpcm_init(&decoder);
+
+   for (unsigned int n = 0; n < 2 * rate; n++) {
+      double t = (double) n / rate;
+      double x = peak * (0.8 * sin(2 * M_PI * 1000 * t) + 0.2 * sin(2 * M_PI * 300 * t));
+      int16_t in = (int16_t) lrint(x) << 8;
+      int16_t out = adpcm_decode(&decoder, adpcm_encode(&encoder, in));
+
+      if (n < SETTLE_SAMPLES) continue;
+      signal += (double) in * in;
+      noise += (double) (in - out) * (in - out);
+   }
+
+   return 10 * log10(signal / noise);
+}
+
+int main(void) {
+   int failed = 0;
+
+   for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      double snr = snr_db(cases[c].rate, cases[c].level_db);
+      bool ok = snr >= cases[c].limit_db;
+
+      printf("%5u Hz  level %6.1f dBFS  SNR %5.1f dB  (min %4.1f)  %s\n",
+             cases[c].rate, cases[c].level_db, snr, cases[c].limit_db, ok ? "ok" : "FAIL");
+      if (!ok) failed = 1;
+   }
+
+   return failed;
+}
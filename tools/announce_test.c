@@ -0,0 +1,149 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * announce_test.c
+ *
+ * Host test of the announcement scheduler against a
+ * plain linear model. Random schedules, cancels, clock
+ * ticks and announce_next() calls, with the clock
+ * starting just before it wraps. The model keeps its
+ * own queued flag and due time per announcement and at
+ * every step announce_next() must return what a linear
+ * scan picks: the due, eligible announcement with the
+ * lowest priority value, then the earliest due. Ties
+ * on both may come in any order. announce_schedule()
+ * must fail exactly when the policy is full and
+ * announce_pending() must agree with the model.
+ *
+ * announce_test    exits 1 on the first mismatch
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include "../announce.h"
+#include "host/xorshift.h"
+
+#define ENTRIES         20
+#define STEPS           2000000L
+#define START_TIME      (UINT_MAX - 500)
+
+typedef struct _model_t {
+   bool queued;
+   unsigned int due;
+} model_t;
+
+static announce_t announces[ENTRIES];
+static model_t model[ENTRIES];
+static unsigned int now = START_TIME;
+
+static void play(const void *arg) {
+   (void) arg;
+}
+
+static bool model_due(int i) {
+   return model[i].queued && (int) (now - model[i].due) >= 0;
+}
+
+static unsigned int model_count(bool idle_only) {
+   unsigned int count = 0;
+
+   for (int i = 0; i < ENTRIES; i++) {
+      if (model[i].queued && announces[i].idle_only == idle_only) count++;
+   }
+   return count;
+}
+
+/* Linear reference of announce_next(), -1 if none */
+
+static int model_next(bool idle) {
+   int best = -1;
+
+   for (int i = 0; i < ENTRIES; i++) {
+      if (!model_due(i) || (announces[i].idle_only && !idle)) continue;
+      if (best < 0 || announces[i].priority < announces[best].priority
+          || (announces[i].priority == announces[best].priority
+              && (int) (model[i].due - model[best].due) < 0)) {
+         best = i;
+      }
+   }
+   return best;
+}
+
+static bool check(bool ok, long step, const char *what) {
+   if (!ok) printf("step %ld at %u: %s\n", step, now, what);
+   return ok;
+}
+
+int main(void) {
+   long nexts = 0, played = 0, full = 0;
+
+   for (int i = 0; i < ENTRIES; i++) {
+      unsigned int period = xorshift_below(3) ? xorshift_below(50) : 0;
+      announce_init(&announces[i], play, NULL, period, xorshift_below(4), xorshift_below(2));
+   }
+
+   for (long step = 0; step < STEPS; step++) {
+      unsigned int action = xorshift_below(10);
+      int k = xorshift_below(ENTRIES);
+
+      if (action < 3) {
+         unsigned int delay = xorshift_below(40);
+         bool fits, done;
+
+         model[k].queued = false;
+         fits = model_count(announces[k].idle_only) < ANNOUNCE_MAX;
+         done = announce_schedule(&announces[k], now, delay);
+         if (!check(done == fits, step, "schedule result")) return 1;
+         if (done) {
+            model[k].queued = true;
+            model[k].due = now + delay;
+         } else {
+            full++;
+         }
+      } else if (action < 4) {
+         announce_cancel(&announces[k]);
+         model[k].queued = false;
+      } else if (action < 5) {
+         now++;
+      } else {
+         bool idle = xorshift_below(2);
+         int expected = model_next(idle);
+         announce_t *got = announce_next(now, idle);
+         int index = got != NULL ? got - announces : -1;
+
+         nexts++;
+         if (expected < 0 || index < 0) {
+            if (!check(index == expected, step, "next, due or not")) return 1;
+            continue;
+         }
+
+         /* Equal on both keys, either is right */
+         if (!check(index == expected
+                    || (announces[index].priority == announces[expected].priority
+                        && model[index].due == model[expected].due && model_due(index)),
+                    step, "next, order")) {
+            return 1;
+         }
+
+         played++;
+         if (announces[index].period > 0) {
+            model[index].due = now + announces[index].period;
+         } else {
+            model[index].queued = false;
+         }
+      }
+
+      for (int i = 0; i < ENTRIES; i++) {
+         if (!check(announce_pending(&announces[i], now) == model_due(i), step, "pending")) return 1;
+      }
+   }
+
+   printf("%ld steps, %ld next calls, %ld played, %ld schedules on a full queue, ok\n",
+          STEPS, nexts, played, full);
+
+   return 0;
+}
@@ -0,0 +1,112 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * cor_bench.c
+ *
+ * Host bench of the COR filter, key up and drop latency
+ * against glitch rejection. A 2 s key up in the middle of
+ * a 4 s trace, sampled on the 100us tick, has each sample
+ * flipped with some probability. Per filter setting and
+ * glitch rate it prints the mean latency of the first edge
+ * after each real transition and the spurious edges.
+ *
+ * Filtered settings must not give spurious edges and their
+ * latencies must stay under twice the nominal times. The
+ * unfiltered (one tick) setting is only printed, as the
+ * reference of what the filter buys.
+ *
+ * cor_bench    exits 1 if any filtered case fails
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../cor.h"
+#include "host/xorshift.h"
+
+#define TICKS_PER_MS    10
+#define TRACE_TICKS     40000
+#define KEY_UP_TICK     10000
+#define KEY_DOWN_TICK   30000
+#define TRACES          50
+#define KERCHUNK_MS     500
+
+typedef struct _cor_case_t {
+   double attack_ms;
+   double release_ms;
+   bool checked;           /* Limits apply */
+} cor_case_t;
+
+/* The firmware default is 5 ms / 20 ms, see main.c */
+
+static const cor_case_t cases[] = {
+   {  0.1,  0.1, false },
+   {  2.0, 10.0, true },
+   {  5.0, 20.0, true },
+   { 10.0, 40.0, true },
+};
+
+static const double glitch_rates[] = { 0.0, 0.01, 0.05, 0.20 };
+
+int main(void) {
+   int failed = 0;
+
+   for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      for (unsigned int g = 0; g < sizeof(glitch_rates) / sizeof(glitch_rates[0]); g++) {
+         const cor_case_t *test = &cases[c];
+         double glitch = glitch_rates[g];
+         long up_latency = 0, down_latency = 0, spurious = 0;
+         unsigned int ups = 0, downs = 0;
+         double up_ms, down_ms;
+         bool ok = true;
+
+         xorshift_reset();
+         for (unsigned int trace = 0; trace < TRACES; trace++) {
+            long up = -1, down = -1, edges = 0;
+            cor_t cor;
+
+            cor_init(&cor, test->attack_ms * TICKS_PER_MS, test->release_ms * TICKS_PER_MS, KERCHUNK_MS * TICKS_PER_MS);
+            for (long t = 0; t < TRACE_TICKS; t++) {
+               bool raw = t >= KEY_UP_TICK && t < KEY_DOWN_TICK;
+               cor_edge_t edge;
+
+               if (xorshift_unit() < glitch) raw = !raw;
+               edge = cor_update(&cor, raw);
+               if (edge == COR_EDGE_UP) {
+                  edges++;
+                  if (up < 0 && t >= KEY_UP_TICK) up = t;
+               } else if (edge == COR_EDGE_DOWN) {
+                  edges++;
+                  if (down < 0 && t >= KEY_DOWN_TICK) down = t;
+               }
+            }
+
+            if (up >= 0) {
+               up_latency += up - KEY_UP_TICK;
+               ups++;
+            }
+            if (down >= 0) {
+               down_latency += down - KEY_DOWN_TICK;
+               downs++;
+            }
+            spurious += edges - (up >= 0) - (down >= 0);
+         }
+
+         up_ms = ups ? (double) up_latency / ups / TICKS_PER_MS : 0;
+         down_ms = downs ? (double) down_latency / downs / TICKS_PER_MS : 0;
+         if (test->checked) {
+            ok = ups == TRACES && downs == TRACES && spurious == 0
+               && up_ms <= 2 * test->attack_ms && down_ms <= 2 * test->release_ms;
+         }
+
+         printf("attack %4.1f ms  release %4.1f ms  glitch %3.0f%%  key up %6.2f ms  drop %6.2f ms  spurious %8.2f/trace  %s\n",
+                test->attack_ms, test->release_ms, glitch * 100, up_ms, down_ms,
+                (double) spurious / TRACES, test->checked ? (ok ? "ok" : "FAIL") : "-");
+         if (!ok) failed = 1;
+      }
+   }
+
+   return failed;
+}
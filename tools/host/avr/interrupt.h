@@ -0,0 +1,20 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * avr/interrupt.h
+ *
+ * Host stand in for the avr-libc header. An ISR is a
+ * plain function the host test can call.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _AVR_INTERRUPT_H_
+#define _AVR_INTERRUPT_H_
+
+#define ISR(vector)     void vector(void)
+
+#define sei()
+#define cli()
+
+#endif /* _AVR_INTERRUPT_H_ */
@@ -0,0 +1,48 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * avr/io.h
+ *
+ * Host stand in for the avr-libc header, so firmware
+ * modules build into the host tests. The registers are
+ * plain variables, defined in io.c, and only the ones
+ * the host tested modules touch are here. Inputs are
+ * set by writing PINx. The firmware writes PINx through
+ * io_pin_write(), which toggles the PORTx bits written
+ * as 1, like the AVR.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _AVR_IO_H_
+#define _AVR_IO_H_
+
+#include <stdint.h>
+
+extern volatile uint8_t PINB, DDRB, PORTB;
+extern volatile uint8_t PINC, DDRC, PORTC;
+extern volatile uint8_t PIND, DDRD, PORTD;
+extern volatile uint8_t TCCR1B, TIMSK1;
+extern volatile uint16_t ICR1;
+
+void io_pin_write(volatile uint8_t *pin, uint8_t mask);
+
+#define _BV(bit)        (1 << (bit))
+
+#define PINB0           0
+#define PINB5           5
+#define PORTB3          3
+#define PINC1           1
+#define PORTC0          0
+#define PORTD0          0
+#define PORTD1          1
+#define PORTD2          2
+#define PORTD3          3
+#define PORTD4          4
+#define PORTD5          5
+
+#define ICNC1           7
+#define ICES1           6
+#define ICIE1           5
+
+#endif /* _AVR_IO_H_ */
@@ -0,0 +1,21 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * util/atomic.h
+ *
+ * Host stand in for the avr-libc header, so firmware
+ * modules build into the host tests. There are no
+ * interrupts on the host, the block runs once.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _UTIL_ATOMIC_H_
+#define _UTIL_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+
+#define ATOMIC_BLOCK(type)       for (int _atomic_once = 1; _atomic_once; _atomic_once = 0)
+
+#endif /* _UTIL_ATOMIC_H_ */
@@ -0,0 +1,55 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * xorshift.h
+ *
+ * Random numbers of the host benches. A fixed xorshift
+ * (13, 17, 5) from a fixed seed, so every run, on every
+ * libc, sees the same traces and the same results.
+ * Each bench is a single file, the state is per bench.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _XORSHIFT_H_
+#define _XORSHIFT_H_
+
+#include <stdint.h>
+
+#define XORSHIFT_SEED   2463534242u
+
+static uint32_t xorshift_state = XORSHIFT_SEED;
+
+/* xorshift_reset
+ * Back to the seed, e.g. to give every case the
+ * same traces.
+ */
+
+static inline void xorshift_reset(void) {
+   xorshift_state = XORSHIFT_SEED;
+}
+
+static inline uint32_t xorshift_next(void) {
+   xorshift_state ^= xorshift_state << 13;
+   xorshift_state ^= xorshift_state >> 17;
+   xorshift_state ^= xorshift_state << 5;
+   return xorshift_state;
+}
+
+/* xorshift_unit
+ * Uniform in (0, 1), never 0 so log() of it is safe.
+ */
+
+static inline double xorshift_unit(void) {
+   return (xorshift_next() + 1.0) / 4294967297.0;
+}
+
+/* xorshift_below
+ * 0 to n - 1, n much smaller than 2^32.
+ */
+
+static inline unsigned int xorshift_below(unsigned int n) {
+   return xorshift_next() % n;
+}
+
+#endif /* _XORSHIFT_H_ */
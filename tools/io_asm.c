@@ -0,0 +1,67 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * io_asm.c
+ *
+ * Not linked into anything. make io-asm compiles it with
+ * the firmware flags and prints the instructions of each
+ * function, see tools/isr_cycles.sh. Every pair is the
+ * same operation with the old helpers (bit number on a
+ * named port) and with the io.h descriptors.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdbool.h>
+#include <avr/io.h>
+#include "../io.h"
+
+/* The helpers as they were before the descriptors */
+
+#define OLD_ENABLE(port, out)    (port |= _BV(out))
+#define OLD_DISABLE(port, out)   (port &= ~_BV(out))
+#define OLD_TOGGLE(port, out)    (port ^= _BV(out))
+#define OLD_IS_ENABLED(port, in) (port && _BV(in))
+
+void old_ptt_on(void) {
+   OLD_ENABLE(PORTD, PORTD0);
+}
+
+void new_ptt_on(void) {
+   IO_ENABLE(IO_PTT);
+}
+
+void old_ptt_off(void) {
+   OLD_DISABLE(PORTD, PORTD0);
+}
+
+void new_ptt_off(void) {
+   IO_DISABLE(IO_PTT);
+}
+
+/* PTT and TX led, two writes before */
+
+void old_tx_on(void) {
+   OLD_ENABLE(PORTD, PORTD0);
+   OLD_ENABLE(PORTD, PORTD3);
+}
+
+void new_tx_on(void) {
+   IO_ENABLE(IO_TX);
+}
+
+void old_beep_toggle(void) {
+   OLD_TOGGLE(PORTC, PORTC0);
+}
+
+void new_beep_toggle(void) {
+   IO_TOGGLE(IO_BEEP);
+}
+
+bool old_rx(void) {
+   return OLD_IS_ENABLED(PINB, PINB5);
+}
+
+bool new_rx(void) {
+   return IO_IS_ENABLED(IO_RPT_RX);
+}
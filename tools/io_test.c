@@ -0,0 +1,92 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * io_test.c
+ *
+ * Host test of the io.h helpers, built against the
+ * host registers of io.c. Inputs are set by writing
+ * PINx, outputs are read back from PORTx and DDRx.
+ * Covers IO_IS_ENABLED with other pins of the port
+ * set (the old helper was true for any non zero
+ * port), the two pin IO_TX, IO_TOGGLE as a PINx write
+ * (only the pins written as 1 toggle, as on the AVR)
+ * and the direction helpers of every descriptor.
+ *
+ * io_test    exits 1 if any check fails
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../io.h"
+
+static int failed = 0;
+
+static void check(bool ok, const char *what) {
+   printf("%-48s %s\n", what, ok ? "ok" : "FAIL");
+   if (!ok) failed = 1;
+}
+
+int main(void) {
+   /* Inputs */
+   PINB = 0;
+   check(!IO_IS_ENABLED(IO_RPT_RX), "IO_IS_ENABLED, port clear");
+   PINB = (uint8_t) ~_BV(PINB5);
+   check(!IO_IS_ENABLED(IO_RPT_RX), "IO_IS_ENABLED, every other pin set");
+   PINB = _BV(PINB5);
+   check(IO_IS_ENABLED(IO_RPT_RX), "IO_IS_ENABLED, pin set");
+   PINB = _BV(PINB0);
+   check(IO_IS_ENABLED(IO_TONE_IN) && !IO_IS_ENABLED(IO_RPT_RX), "IO_IS_ENABLED, pins apart");
+
+   /* IO_TX is PTT and the TX led together */
+   PORTD = 0;
+   IO_ENABLE(IO_TX);
+   check(PORTD == (_BV(PORTD0) | _BV(PORTD3)), "IO_ENABLE(IO_TX) sets both pins");
+   PIND = 0;
+   check(!IO_IS_ENABLED(IO_TX), "IO_IS_ENABLED reads PINx, not PORTx");
+   IO_ENABLE(IO_LED_RX);
+   IO_DISABLE(IO_TX);
+   check(PORTD == _BV(PORTD2), "IO_DISABLE(IO_TX) leaves the other pins");
+   IO_ENABLE(IO_PTT);
+   check(PORTD == (_BV(PORTD0) | _BV(PORTD2)), "IO_ENABLE(IO_PTT) is one pin");
+   IO_DISABLE(IO_LED_RX);
+   IO_DISABLE(IO_PTT);
+   check(PORTD == 0, "IO_DISABLE one pin at a time");
+
+   /* Toggle */
+   PORTC = 0;
+   IO_TOGGLE(IO_BEEP);
+   check(PORTC == _BV(PORTC0), "IO_TOGGLE(IO_BEEP) on");
+   IO_TOGGLE(IO_BEEP);
+   check(PORTC == 0, "IO_TOGGLE(IO_BEEP) off");
+   PINC = _BV(PINC1);
+   PORTC = (uint8_t) ~_BV(PORTC0);
+   IO_TOGGLE(IO_BEEP);
+   check(PORTC == 0xFF && PINC == _BV(PINC1), "IO_TOGGLE(IO_BEEP) leaves other pins and PINC");
+   PORTD = _BV(PORTD0) | _BV(PORTD2);
+   IO_TOGGLE(IO_TX);
+   check(PORTD == (_BV(PORTD2) | _BV(PORTD3)), "IO_TOGGLE(IO_TX) toggles both pins");
+   PORTD = 0;
+
+   /* Direction, as setup_io, audio.c and tone.c use it */
+   DDRB = 0xFF;
+   IO_INPUT(IO_RPT_RX);
+   IO_INPUT(IO_TONE_IN);
+   check(DDRB == (uint8_t) ~(_BV(PINB5) | _BV(PINB0)), "IO_INPUT(IO_RPT_RX), IO_INPUT(IO_TONE_IN)");
+   DDRB = 0;
+   IO_OUTPUT(IO_PWM_OUT);
+   check(DDRB == _BV(PORTB3), "IO_OUTPUT(IO_PWM_OUT)");
+   DDRC = 0x7F;
+   IO_INPUT(IO_RX_AUDIO);
+   check(DDRC == (0x7F & ~_BV(PINC1)), "IO_INPUT(IO_RX_AUDIO)");
+   DDRD = 0;
+   IO_OUTPUT(IO_TX);
+   check(DDRD == (_BV(PORTD0) | _BV(PORTD3)), "IO_OUTPUT(IO_TX) sets both pins");
+
+   /* Single pin check, picks sbi/cbi or the atomic block */
+   check(IO_SINGLE(_BV(PORTD5)) && !IO_SINGLE(_BV(PORTD0) | _BV(PORTD3)), "IO_SINGLE");
+
+   return failed;
+}
@@ -0,0 +1,107 @@
+#!/bin/sh
+#
+# isr_cycles.sh
+#
+# Static cycle bound of functions in an AVR ELF file,
+# from the avr-objdump disassembly.
+#
+# isr_cycles.sh <elf> <symbol> [symbol ...]
+#
+# For each symbol prints the instructions and the worst case
+# cycles of the function plus everything it calls, one call
+# counted per call site. Every instruction is taken once with
+# its longest timing (branches taken, skips skipping), which
+# bounds loop free code. Functions with a backward branch are
+# flagged LOOP, their figure is one pass only.
+# ATmega328P timings: call 4, rcall/jmp/lpm 3, ret/reti 4.
+#
+# José Miguel Fonte
+
+OBJDUMP=${OBJDUMP:-avr-objdump}
+
+if [ $# -lt 2 ] || [ ! -f "$1" ]; then
+   echo "usage: $0 <elf> <symbol> [symbol ...]" >&2
+   exit 2
+fi
+
+ELF=$1
+shift
+
+${OBJDUMP} -d "${ELF}" | awk -v roots="$*" '
+   function hex(s,    n, i) {
+      s = tolower(s)
+      sub(/^0x/, "", s)
+      n = 0
+      for (i = 1; i <= length(s); i++) n = n * 16 + index("0123456789abcdef", substr(s, i, 1)) - 1
+      return n
+   }
+
+   function cycles(op) {
+      if (op ~ /^(call|ret|reti)$/) return 4
+      if (op ~ /^(rcall|icall|jmp|lpm)$/) return 3
+      if (op ~ /^(cpse|sbrc|sbrs|sbic|sbis)$/) return 3
+      if (op ~ /^(adiw|sbiw|mul|muls|mulsu|fmul|fmuls|fmulsu|ld|ldd|st|std|lds|sts|push|pop|cbi|sbi|rjmp|ijmp)$/) return 2
+      if (op ~ /^br/) return 2
+      return 1
+   }
+
+   function cost(f,    total, n, c) {
+      if (f in busy) return 0
+      if (f in memo) return memo[f]
+      busy[f] = 1
+      total = own[f]
+      for (n = 1; n <= ncalls[f]; n++) {
+         c = callee[f, n]
+         total += cost(c)
+         count[f] += count[c]
+         if (c in loop) loop[f] = 1
+      }
+      delete busy[f]
+      memo[f] = total
+      return total
+   }
+
+   /^[0-9a-f]+ <.*>:$/ {
+      f = $2
+      gsub(/[<>:]/, "", f)
+      start[f] = hex($1)
+      next
+   }
+
+   f != "" && /^ +[0-9a-f]+:\t/ {
+      split($0, part, "\t")
+      addr = part[1]
+      gsub(/[ :]/, "", addr)
+      addr = hex(addr)
+      op = part[3]
+      gsub(/ /, "", op)
+      if (op == "" || op == ".word") next
+      own[f] += cycles(op)
+      count[f]++
+      # Calls, and jumps into another function (tail calls)
+      if (op ~ /^(call|rcall|jmp|rjmp)$/ && match($0, /<[^>+]+>/)) {
+         c = substr($0, RSTART + 1, RLENGTH - 2)
+         if (c != f) {
+            ncalls[f]++
+            callee[f, ncalls[f]] = c
+         }
+      }
+      if ((op ~ /^br/ || op == "rjmp") && match($0, /; 0x[0-9a-f]+/)) {
+         target = hex(substr($0, RSTART + 2, RLENGTH - 2))
+         if (target <= addr && target >= start[f]) loop[f] = 1
+      }
+   }
+
+   END {
+      n = split(roots, root, " ")
+      for (r = 1; r <= n; r++) {
+         if (!(root[r] in start)) {
+            printf "%-24s not found\n", root[r]
+            missing = 1
+            continue
+         }
+         total = cost(root[r])
+         printf "%-24s %5d instructions %6d cycles%s\n", root[r], count[root[r]], total, (root[r] in loop) ? "  LOOP" : ""
+      }
+      exit missing
+   }'
@@ -0,0 +1,79 @@
+#!/bin/sh
+#
+# size_report.sh
+#
+# Per symbol flash and RAM usage of an AVR ELF file.
+#
+# size_report.sh <elf>              prints the report (baseline format)
+# size_report.sh <elf> <baseline>   compares against the baseline and
+#                                   exits 1 if any symbol or total grew,
+#                                   or if there is no baseline (the
+#                                   report is printed then, ready to be
+#                                   checked and committed as baseline)
+#
+# Report lines are: <flash bytes> <ram bytes> <symbol>
+# .text symbols count as flash, .bss as RAM, .data as both
+# (initial values live in flash and are copied to RAM).
+#
+# José Miguel Fonte
+
+NM=${NM:-avr-nm}
+
+if [ $# -lt 1 ] || [ ! -f "$1" ]; then
+   echo "usage: $0 <elf> [baseline]" >&2
+   exit 2
+fi
+
+report() {
+   ${NM} --size-sort --print-size --radix=d "$1" | awk '
+      NF == 4 {
+         size = $2 + 0; type = $3; name = $4
+         if (type ~ /[tTwW]/) flash[name] += size
+         else if (type ~ /[dD]/) { flash[name] += size; ram[name] += size }
+         else if (type ~ /[bB]/) ram[name] += size
+         else next
+         seen[name] = 1
+      }
+      END {
+         for (name in seen) {
+            printf "%d %d %s\n", flash[name], ram[name], name
+            total_flash += flash[name]; total_ram += ram[name]
+         }
+         printf "%d %d %s\n", total_flash, total_ram, "TOTAL"
+      }' | sort -k3
+}
+
+if [ $# -lt 2 ]; then
+   report "$1"
+   exit 0
+fi
+
+if [ ! -f "$2" ]; then
+   report "$1"
+   echo "No baseline $2, record one with make size-baseline and commit it" >&2
+   exit 1
+fi
+
+report "$1" | awk '
+   NR == FNR { base_flash[$3] = $1; base_ram[$3] = $2; next }
+   {
+      name = $3; flash = $1; ram = $2
+      old_flash = (name in base_flash) ? base_flash[name] : 0
+      old_ram = (name in base_ram) ? base_ram[name] : 0
+      if (flash > old_flash || ram > old_ram) {
+         printf "GREW  %-32s flash %5d -> %5d  ram %4d -> %4d\n", name, old_flash, flash, old_ram, ram
+         grew = 1
+      } else if (flash < old_flash || ram < old_ram) {
+         printf "SHRNK %-32s flash %5d -> %5d  ram %4d -> %4d\n", name, old_flash, flash, old_ram, ram
+      }
+      delete base_flash[name]
+   }
+   END {
+      for (name in base_flash)
+         printf "GONE  %-32s flash %5d -> %5d  ram %4d -> %4d\n", name, base_flash[name], 0, base_ram[name], 0
+      if (grew) {
+         print "Size grew against baseline"
+         exit 1
+      }
+      print "Size OK against baseline"
+   }' "$2" -
@@ -0,0 +1,160 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * squelch_bench.c
+ *
+ * Host bench of the noise squelch, open and close latency
+ * against carrier quieting. Each trace is 3 s of 10 kHz
+ * ADC samples: receiver noise (40 LSB rms), then a 1 s
+ * carrier that quiets the noise by the case's dB, then
+ * noise again. The carrier is modulated with a 1 kHz +
+ * 300 Hz tone pair, or with a single tone at full
+ * deviation (FULL_LSB peak, PC1 level set so full
+ * deviation just fits the ADC): 1 kHz, a 1750 Hz burst
+ * and 2.5 kHz for the sibilants.
+ *
+ * Weak carriers (little quieting) must never open the
+ * squelch. Strong ones must open it within open_ms, close
+ * it within close_ms of the carrier dropping and not
+ * chatter in between, whatever the modulation.
+ *
+ * squelch_bench [open close]   levels, default main.c's
+ *
+ * Exits 1 if any case fails.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "../squelch.h"
+#include "host/xorshift.h"
+
+#define SAMPLE_RATE        10000
+#define TRACE_SAMPLES      30000
+#define CARRIER_ON         10000
+#define CARRIER_OFF        20000
+#define TRACES             20
+#define NOISE_RMS          40.0
+#define FULL_LSB           100.0
+
+#define OPEN_LEVEL         360
+#define CLOSE_LEVEL        750
+
+typedef struct _squelch_case_t {
+   double quieting_db;
+   double tone_hz;         /* Full deviation tone, 0 for the tone pair */
+   bool opens;             /* false, must stay closed */
+   double open_ms;
+   double close_ms;
+} squelch_case_t;
+
+static const squelch_case_t cases[] = {
+   {  3.0,    0, false,  0.0,  0.0 },
+   {  6.0,    0, false,  0.0,  0.0 },
+   { 10.0,    0, true,  60.0, 10.0 },       /* Near the open level */
+   { 15.0,    0, true,  20.0, 10.0 },
+   { 20.0,    0, true,  20.0, 10.0 },
+   { 30.0,    0, true,  20.0, 10.0 },
+   { 30.0, 1000, true,  20.0, 10.0 },
+   { 30.0, 1750, true,  20.0, 10.0 },
+   { 30.0, 2500, true,  20.0, 10.0 },
+   { 15.0, 1750, true,  20.0, 10.0 },
+};
+
+/* Box-Muller, one of the pair */
+
+static double random_gauss(void) {
+   double u = xorshift_unit();
+   double v = xorshift_unit();
+
+   return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+int main(int argc, char **argv) {
+   unsigned int open = OPEN_LEVEL;
+   unsigned int close = CLOSE_LEVEL;
+   int failed = 0;
+
+   if (argc == 3) {
+      open = atoi(argv[1]);
+      close = atoi(argv[2]);
+   } else if (argc != 1) {
+      fprintf(stderr, "usage: %s [open close]\n", argv[0]);
+      return 2;
+   }
+
+   printf("levels open %u close %u\n", open, close);
+
+   for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      const squelch_case_t *test = &cases[c];
+      double quieted = NOISE_RMS * pow(10.0, -test->quieting_db / 20.0);
+      long open_latency = 0, close_latency = 0, extra = 0;
+      unsigned int opened = 0, closed = 0;
+      double open_ms, close_ms;
+      char modulation[16];
+      bool ok;
+
+      for (unsigned int trace = 0; trace < TRACES; trace++) {
+         long t_open = -1, t_close = -1, edges = 0;
+         bool previous = false;
+
+         squelch_init(open, close);
+         for (long t = 0; t < TRACE_SAMPLES; t++) {
+            bool on = t >= CARRIER_ON && t < CARRIER_OFF;
+            double x = (on ? quieted : NOISE_RMS) * random_gauss();
+            bool carrier;
+
+            if (on && test->tone_hz > 0) {
+               x += FULL_LSB * sin(2 * M_PI * test->tone_hz * t / SAMPLE_RATE);
+            } else if (on) {
+               x += 30 * sin(2 * M_PI * 1000 * t / SAMPLE_RATE) + 20 * sin(2 * M_PI * 300 * t / SAMPLE_RATE);
+            }
+            if (x > 127) x = 127;
+            if (x < -128) x = -128;
+
+            squelch_sample((int8_t) lrint(x));
+            carrier = squelch_carrier();
+            if (carrier != previous) {
+               edges++;
+               if (carrier && on && t_open < 0) t_open = t;
+               if (!carrier && t >= CARRIER_OFF && t_close < 0) t_close = t;
+            }
+            previous = carrier;
+         }
+
+         if (t_open >= 0) {
+            open_latency += t_open - CARRIER_ON;
+            opened++;
+         }
+         if (t_close >= 0) {
+            close_latency += t_close - CARRIER_OFF;
+            closed++;
+         }
+         extra += edges - (t_open >= 0) - (t_close >= 0);
+      }
+
+      open_ms = opened ? 1000.0 * open_latency / opened / SAMPLE_RATE : 0;
+      close_ms = closed ? 1000.0 * close_latency / closed / SAMPLE_RATE : 0;
+      if (test->opens) {
+         ok = opened == TRACES && closed == TRACES && extra == 0
+            && open_ms <= test->open_ms && close_ms <= test->close_ms;
+      } else {
+         ok = opened == 0 && extra == 0;
+      }
+
+      if (test->tone_hz > 0) {
+         snprintf(modulation, sizeof(modulation), "%4.0f Hz", test->tone_hz);
+      } else {
+         snprintf(modulation, sizeof(modulation), "tone pair");
+      }
+      printf("quieting %4.1f dB  %-9s  opened %2u/%u  open %5.1f ms  close %5.1f ms  extra edges %5.2f/trace  %s\n",
+             test->quieting_db, modulation, opened, TRACES, open_ms, close_ms, (double) extra / TRACES, ok ? "ok" : "FAIL");
+      if (!ok) failed = 1;
+   }
+
+   return failed;
+}
@@ -0,0 +1,153 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * tone_bench.c
+ *
+ * Host bench of the tone burst detector, with main.c's
+ * 1750 Hz +/- 25 Hz, 250 ms settings. Rising edges are
+ * fed to tone_capture() as TIMER 1 capture times, with
+ * the 50 ms wrap and tone_idle() of the firmware.
+ *
+ * Bursts of 500 ms, with +/- 20us of edge jitter, are
+ * swept in frequency. Near the nominal frequency they
+ * must be detected within TONE_LATENCY_MS, well outside
+ * the tolerance they must not. Right at the window edges
+ * either is fine, only the result is printed. Then long
+ * runs of noise (random edges) and of a jittery 1 kHz
+ * tone must give no detection at all, nor steady tones
+ * whose 16 periods alias onto the 1750 Hz block span
+ * modulo the 50 ms wrap (270.5 Hz, 146.6 Hz).
+ *
+ * tone_bench    exits 1 if any case fails
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "../event.h"
+#include "../tone.h"
+#include "host/xorshift.h"
+
+#define TIMER_HZ           1000000.0
+#define TIMER_WRAP         50000
+#define IDLE_SEC           0.05
+
+#define TONE_FREQ_HZ       1750
+#define TONE_TOLERANCE_HZ  25
+#define TONE_MIN_MS        250
+#define TONE_LATENCY_MS    350         /* TONE_MIN_MS plus a few bad blocks */
+
+typedef enum {
+   EXPECT_DETECT,
+   EXPECT_REJECT,
+   EXPECT_EITHER
+} expect_t;
+
+typedef struct _tone_case_t {
+   const char *name;
+   double rate_hz;         /* Tone frequency, or mean noise edge rate */
+   bool noise;             /* Random edges instead of a tone */
+   double jitter_us;       /* Edge jitter, +/- */
+   double duration_sec;
+   expect_t expect;
+} tone_case_t;
+
+static const tone_case_t cases[] = {
+   { "tone",  1650,  false,  20,   0.5, EXPECT_REJECT },
+   { "tone",  1700,  false,  20,   0.5, EXPECT_REJECT },
+   { "tone",  1720,  false,  20,   0.5, EXPECT_EITHER },
+   { "tone",  1730,  false,  20,   0.5, EXPECT_EITHER },
+   { "tone",  1740,  false,  20,   0.5, EXPECT_DETECT },
+   { "tone",  1750,  false,  20,   0.5, EXPECT_DETECT },
+   { "tone",  1760,  false,  20,   0.5, EXPECT_DETECT },
+   { "tone",  1770,  false,  20,   0.5, EXPECT_EITHER },
+   { "tone",  1780,  false,  20,   0.5, EXPECT_EITHER },
+   { "tone",  1800,  false,  20,   0.5, EXPECT_REJECT },
+   { "tone",  1850,  false,  20,   0.5, EXPECT_REJECT },
+   { "tone",  2000,  false,  20,   0.5, EXPECT_REJECT },
+   { "short", 1750,  false,  20,   0.2, EXPECT_REJECT },
+   { "noise", 1750,  true,    0, 600.0, EXPECT_REJECT },
+   { "noise", 3500,  true,    0, 600.0, EXPECT_REJECT },
+   { "tone",  1000,  false, 300, 600.0, EXPECT_REJECT },
+   { "alias", 270.5, false,  20,  60.0, EXPECT_REJECT },
+   { "alias", 146.6, false,  20,  60.0, EXPECT_REJECT },
+};
+
+static double now;
+static double idle_next;
+static double detect_time;
+static unsigned int detections;
+
+/* Stands in for event.c, counts the bursts */
+
+bool event_push(unsigned char type) {
+   if (type == EVENT_TONE_BURST) {
+      if (detections == 0) detect_time = now;
+      detections++;
+   }
+   return true;
+}
+
+static void idle_until(double end) {
+   while (idle_next <= end) {
+      now = idle_next;
+      tone_idle();
+      idle_next += IDLE_SEC;
+   }
+   now = end;
+}
+
+static void run(const tone_case_t *test) {
+   double end = now + test->duration_sec;
+   double t = now;
+
+   while (true) {
+      if (test->noise) {
+         t += -log(xorshift_unit()) / test->rate_hz;
+      } else {
+         t += 1.0 / test->rate_hz + (2 * xorshift_unit() - 1) * test->jitter_us / TIMER_HZ;
+      }
+      if (t > end) break;
+
+      idle_until(t);
+      tone_capture((unsigned long) (t * TIMER_HZ) % TIMER_WRAP);
+   }
+
+   idle_until(end);
+}
+
+int main(void) {
+   static const char *expects[] = { "detect", "reject", "either" };
+   int failed = 0;
+
+   tone_init(TIMER_WRAP, TONE_FREQ_HZ, TONE_TOLERANCE_HZ, TONE_MIN_MS);
+
+   for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      const tone_case_t *test = &cases[c];
+      double start, latency_ms;
+      bool ok = true;
+
+      idle_until(now + 0.2);
+      start = now;
+      detections = 0;
+      run(test);
+      idle_until(now + 0.2);
+
+      latency_ms = detections ? (detect_time - start) * 1000 : 0;
+      if (test->expect == EXPECT_DETECT) {
+         ok = detections == 1 && latency_ms <= TONE_LATENCY_MS;
+      } else if (test->expect == EXPECT_REJECT) {
+         ok = detections == 0;
+      }
+
+      printf("%-5s %6.1f Hz  jitter %3.0fus  %5.1f s  detections %u  latency %5.1f ms  (%s)  %s\n",
+             test->name, test->rate_hz, test->jitter_us, test->duration_sec, detections, latency_ms,
+             expects[test->expect], test->expect == EXPECT_EITHER ? "-" : (ok ? "ok" : "FAIL"));
+      if (!ok) failed = 1;
+   }
+
+   return failed;
+}
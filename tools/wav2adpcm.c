@@ -0,0 +1,214 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * wav2adpcm.c
+ *
+ * Host tool. Converts a PCM WAV file (8 or 16 bit, mono
+ * or stereo, any rate) into voice_clip.c, a 4 bit ADPCM
+ * flash image for voice_play(). Uses the firmware codec
+ * so the stream decodes exactly the same on the AVR.
+ *
+ * wav2adpcm [-b max_bytes] <input.wav> <output.c>
+ *
+ * Fails, writing nothing, if the clip needs more than
+ * max_bytes of flash (default MAX_BYTES).
+ *
+ * José Miguel Fonte
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+#include "../adpcm.h"
+#include "../voice.h"
+
+/* Flash is 32K and the firmware needs its share, the
+ * default leaves it half. voice_clip_samples is 16 bit
+ * on the AVR, which also caps the clip at 32K.
+ */
+
+#define MAX_BYTES    16384
+#define LIMIT_BYTES  32767
+
+typedef struct {
+   unsigned int channels;
+   unsigned int rate;
+   unsigned int bits;
+   long length;            /* frames */
+   int16_t *samples;       /* mono */
+} wav_t;
+
+static uint32_t le32(const uint8_t *b) {
+   return b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t) b[3] << 24);
+}
+
+static uint16_t le16(const uint8_t *b) {
+   return b[0] | (b[1] << 8);
+}
+
+static int wav_read(const char *path, wav_t *wav) {
+   FILE *file = fopen(path, "rb");
+   uint8_t header[12], chunk[8], fmt[16];
+   bool have_fmt = false;
+
+   if (file == NULL) {
+      perror(path);
+      return -1;
+   }
+
+   if (fread(header, 1, 12, file) != 12 || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) {
+      fprintf(stderr, "%s: not a WAV file\n", path);
+      fclose(file);
+      return -1;
+   }
+
+   while (fread(chunk, 1, 8, file) == 8) {
+      uint32_t size = le32(chunk + 4);
+
+      if (!memcmp(chunk, "fmt ", 4) && size >= 16) {
+         if (fread(fmt, 1, 16, file) != 16) break;
+         fseek(file, size - 16 + (size & 1), SEEK_CUR);
+         if (le16(fmt) != 1) {
+            fprintf(stderr, "%s: only PCM is supported\n", path);
+            break;
+         }
+         wav->channels = le16(fmt + 2);
+         wav->rate = le32(fmt + 4);
+         wav->bits = le16(fmt + 14);
+         have_fmt = (wav->bits == 8 || wav->bits == 16) && wav->channels > 0;
+         if (!have_fmt) {
+            fprintf(stderr, "%s: only 8 and 16 bit samples are supported\n", path);
+            break;
+         }
+      } else if (!memcmp(chunk, "data", 4) && have_fmt) {
+         unsigned int frame = wav->channels * wav->bits / 8;
+         uint8_t *data = malloc(size);
+
+         if (data == NULL || fread(data, 1, size, file) != size) {
+            fprintf(stderr, "%s: truncated data\n", path);
+            free(data);
+            break;
+         }
+
+         wav->length = size / frame;
+         wav->samples = malloc(wav->length * sizeof(int16_t));
+         for (long n = 0; n < wav->length; n++) {
+            long sum = 0;
+            for (unsigned int c = 0; c < wav->channels; c++) {
+               const uint8_t *p = data + n * frame + c * wav->bits / 8;
+               sum += wav->bits == 8 ? (p[0] - 128) << 8 : (int16_t) le16(p);
+            }
+            wav->samples[n] = sum / (long) wav->channels;
+         }
+
+         free(data);
+         fclose(file);
+         return 0;
+      } else {
+         fseek(file, size + (size & 1), SEEK_CUR);
+      }
+   }
+
+   fprintf(stderr, "%s: no usable fmt/data chunks\n", path);
+   fclose(file);
+   return -1;
+}
+
+/* Box filter resampling. Each output sample is the mean
+ * of the input samples it covers, a cheap anti alias
+ * low pass when going down to VOICE_SAMPLE_RATE.
+ */
+
+static int16_t resample(const wav_t *wav, long n) {
+   double step = (double) wav->rate / VOICE_SAMPLE_RATE;
+   long first = (long) (n * step);
+   long last = (long) ((n + 1) * step);
+   long sum = 0;
+
+   if (last <= first) last = first + 1;
+   if (last > wav->length) last = wav->length;
+   for (long i = first; i < last; i++) sum += wav->samples[i];
+
+   return sum / (last - first);
+}
+
+int main(int argc, char **argv) {
+   wav_t wav = { 0 };
+   adpcm_t encoder;
+   adpcm_t decoder;
+   FILE *out;
+   long samples, bytes;
+   long max_bytes = MAX_BYTES;
+   double snr_signal = 0, snr_noise = 0;
+
+   if (argc == 5 && !strcmp(argv[1], "-b")) {
+      char *end;
+
+      max_bytes = strtol(argv[2], &end, 0);
+      if (*end != '\0' || max_bytes <= 0 || max_bytes > LIMIT_BYTES) {
+         fprintf(stderr, "%s: max_bytes must be 1 to %d\n", argv[2], LIMIT_BYTES);
+         return 2;
+      }
+      argc -= 2;
+      argv += 2;
+   }
+
+   if (argc != 3) {
+      fprintf(stderr, "usage: %s [-b max_bytes] <input.wav> <output.c>\n", argv[0]);
+      return 2;
+   }
+
+   if (wav_read(argv[1], &wav) < 0) return 1;
+
+   samples = (long) ((double) wav.length * VOICE_SAMPLE_RATE / wav.rate);
+   bytes = (samples + 1) / 2;
+   if (bytes > max_bytes) {
+      fprintf(stderr, "%s: clip needs %ld flash bytes, %.2f s, only %ld allowed (%.2f s)\n",
+              argv[1], bytes, (double) samples / VOICE_SAMPLE_RATE,
+              max_bytes, 2.0 * max_bytes / VOICE_SAMPLE_RATE);
+      free(wav.samples);
+      return 1;
+   }
+
+   out = fopen(argv[2], "w");
+   if (out == NULL) {
+      perror(argv[2]);
+      return 1;
+   }
+
+   fprintf(out, "/* Generated by tools/wav2adpcm from %s, do not edit */\n\n", argv[1]);
+   fprintf(out, "#include <avr/pgmspace.h>\n#include \"config.h\"\n#include \"voice_clip.h\"\n\n#if VOICE_ID_ENABLED\n\n");
+   fprintf(out, "const unsigned int voice_clip_samples = %ld;\n\n", samples);
+   fprintf(out, "const uint8_t voice_clip[] PROGMEM = {");
+
+   adpcm_init(&encoder);
+   adpcm_init(&decoder);
+   for (long n = 0; n < bytes; n++) {
+      int16_t even = resample(&wav, 2 * n);
+      int16_t odd = 2 * n + 1 < samples ? resample(&wav, 2 * n + 1) : 0;
+      uint8_t low = adpcm_encode(&encoder, even);
+      uint8_t high = adpcm_encode(&encoder, odd);
+      double e = even - adpcm_decode(&decoder, low);
+      double o = odd - adpcm_decode(&decoder, high);
+
+      snr_signal += (double) even * even + (double) odd * odd;
+      snr_noise += e * e + o * o;
+
+      fprintf(out, "%s0x%02x,", n % 16 ? " " : "\n   ", low | (high << 4));
+   }
+   fprintf(out, "\n};\n\n#endif\n");
+   fclose(out);
+
+   fprintf(stderr, "%ld samples at %d Hz, %.2f s, %ld flash bytes, %d bytes/s",
+           samples, VOICE_SAMPLE_RATE, (double) samples / VOICE_SAMPLE_RATE, bytes, VOICE_SAMPLE_RATE / 2);
+   if (snr_noise > 0) {
+      fprintf(stderr, ", codec SNR %.1f dB", 10 * log10(snr_signal / snr_noise));
+   }
+   fprintf(stderr, "\n");
+
+   free(wav.samples);
+   return 0;
+}
@@ -0,0 +1,89 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * voice.c
+ *
+ * Voice implementation file
+ *
+ * Two samples per flash byte, low nibble first,
+ * the same packing as the audio delay line.
+ * The whole playback state is a few bytes.
+ * Only compiled in with VOICE_ID_ENABLED.
+ *
+ * José Miguel Fonte
+ */
+
+#include <stddef.h>
+#include <assert.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+#include "config.h"
+#include "adpcm.h"
+#include "audio.h"
+#include "event.h"
+#include "voice.h"
+
+#if VOICE_ID_ENABLED
+
+#define VOICE_TICK_DIV  (AUDIO_SAMPLE_RATE / VOICE_SAMPLE_RATE)
+
+static const uint8_t *clip_data;
+static unsigned int clip_position;
+static unsigned int clip_samples;
+static unsigned char divider;
+static adpcm_t decoder;
+static volatile bool playing           = false;
+
+/* Public */
+
+/* voice_play
+ * Starts playing a clip from flash and returns at once.
+ * EVENT_VOICE_DONE is pushed when it ends.
+ * Needs the PWM DAC, see audio_dac_init().
+ */
+
+void voice_play(const uint8_t *clip, unsigned int samples) {
+   assert(clip != NULL);
+
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      clip_data = clip;
+      clip_position = 0;
+      clip_samples = samples;
+      divider = 0;
+      adpcm_init(&decoder);
+      audio_dac_claim(true);
+      playing = true;
+   }
+}
+
+bool voice_playing(void) {
+   return playing;
+}
+
+/* voice_tick
+ * Called from the TIMER 0 ISR every 100us.
+ * Decodes and outputs one sample every VOICE_TICK_DIV ticks.
+ */
+
+void voice_tick(void) {
+   uint8_t code;
+
+   if (!playing) return;
+   if (++divider < VOICE_TICK_DIV) return;
+   divider = 0;
+
+   if (clip_position >= clip_samples) {
+      playing = false;
+      audio_dac_claim(false);
+      event_push(EVENT_VOICE_DONE);
+      return;
+   }
+
+   code = pgm_read_byte(clip_data + (clip_position >> 1));
+   if (clip_position & 1) code >>= 4;
+   clip_position++;
+
+   audio_dac_write((adpcm_decode(&decoder, code) >> 8) + 128);
+}
+
+#endif
@@ -0,0 +1,33 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * voice.h
+ *
+ * Voice Header file
+ *
+ * Plays 4 bit ADPCM clips stored in flash through the
+ * PWM DAC. Streams sample by sample, no RAM buffer.
+ * Clips are made with tools/wav2adpcm.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _VOICE_H_
+#define _VOICE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* VOICE_SAMPLE_RATE
+ * Clip sample rate, 2 ticks of 100us. At 4 bits per
+ * sample that is 2500 bytes of flash per second.
+ * 2.5 kHz audio bandwidth, enough for a voice ID.
+ */
+
+#define VOICE_SAMPLE_RATE     5000
+
+void                             voice_play(const uint8_t *clip, unsigned int samples);
+bool                             voice_playing(void);
+void                             voice_tick(void);
+
+#endif /* _VOICE_H_ */
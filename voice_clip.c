@@ -0,0 +1,93 @@
+/* Generated by tools/wav2adpcm from placeholder_chime.wav, do not edit */
+
+#include <avr/pgmspace.h>
+#include "config.h"
+#include "voice_clip.h"
+
+#if VOICE_ID_ENABLED
+
+const unsigned int voice_clip_samples = 2500;
+
+const uint8_t voice_clip[] PROGMEM = {
+   0x77, 0xf7, 0x9f, 0x77, 0xf9, 0x28, 0x04, 0xcc, 0x40, 0x93, 0xad, 0x51, 0xb2, 0x9c, 0x53, 0xb0,
+   0x8c, 0x25, 0xc8, 0x1a, 0x15, 0xba, 0x4a, 0x04, 0xcb, 0x30, 0x83, 0xbd, 0x42, 0xa2, 0x9d, 0x42,
+   0xb0, 0x0b, 0x53, 0xc8, 0x09, 0x14, 0xc9, 0x29, 0x04, 0xba, 0x48, 0x83, 0xbc, 0x41, 0x92, 0x9d,
+   0x32, 0xb1, 0x8d, 0x33, 0xd0, 0x0a, 0x24, 0xc9, 0x2a, 0x14, 0xca, 0x38, 0x03, 0xad, 0x40, 0x92,
+   0xac, 0x42, 0xa1, 0x8c, 0x42, 0xc0, 0x0a, 0x33, 0xd9, 0x2a, 0x33, 0xbc, 0x39, 0x05, 0xcb, 0x40,
+   0x82, 0xac, 0x41, 0x91, 0x9c, 0x33, 0xb0, 0x0e, 0x23, 0xc8, 0x2b, 0x24, 0xda, 0x29, 0x04, 0xca,
+   0x20, 0x84, 0xbb, 0x41, 0x92, 0x9d, 0x42, 0xa0, 0x9b, 0x25, 0xb8, 0x1b, 0x15, 0xd8, 0x29, 0x13,
+   0xdb, 0x38, 0x83, 0xbc, 0x41, 0xa3, 0xac, 0x52, 0xb1, 0x9b, 0x44, 0xb8, 0x0a, 0x24, 0xc9, 0x2a,
+   0x14, 0xca, 0x39, 0x04, 0xcb, 0x30, 0x94, 0xac, 0x32, 0xc3, 0x9b, 0x53, 0xb0, 0x0c, 0x24, 0xc8,
+   0x1a, 0x14, 0xc9, 0x29, 0x04, 0xca, 0x48, 0x82, 0xac, 0x41, 0x91, 0x9c, 0x32, 0xc1, 0x0b, 0x53,
+   0xc8, 0x1a, 0x14, 0xb9, 0x2a, 0x06, 0xba, 0x48, 0x02, 0xbc, 0x41, 0x92, 0x9d, 0x32, 0xb1, 0x0d,
+   0x32, 0xd0, 0x0a, 0x24, 0xc9, 0x19, 0x14, 0xca, 0x38, 0x83, 0xdb, 0x40, 0x92, 0xbb, 0x43, 0xb2,
+   0x8d, 0x42, 0xc0, 0x0a, 0x33, 0xd9, 0x2a, 0x33, 0xbc, 0x39, 0x05, 0xcb, 0x40, 0x82, 0xac, 0x41,
+   0x91, 0x9c, 0x33, 0xb0, 0x0e, 0x23, 0xc8, 0x2b, 0x24, 0xda, 0x29, 0x04, 0xba, 0x38, 0x85, 0xac,
+   0x41, 0x91, 0xab, 0x53, 0xa0, 0x8c, 0x33, 0xd0, 0x0a, 0x24, 0xd9, 0x29, 0x13, 0xdb, 0x20, 0x03,
+   0xad, 0x40, 0x92, 0x9c, 0x41, 0xa1, 0x8c, 0x33, 0xb8, 0x0d, 0x24, 0xb9, 0x3b, 0x24, 0xdb, 0x28,
+   0x04, 0xac, 0x30, 0x93, 0xad, 0x42, 0xa1, 0x9c, 0x43, 0xb0, 0x0c, 0x43, 0xb9, 0x2b, 0x15, 0xc9,
+   0x29, 0x04, 0xca, 0x38, 0x84, 0xac, 0x31, 0xb3, 0x9d, 0x42, 0xb1, 0x0c, 0x42, 0xb8, 0x1b, 0x25,
+   0xca, 0x29, 0x04, 0xca, 0x48, 0x82, 0xbb, 0x51, 0x81, 0x9d, 0x32, 0xb1, 0x8d, 0x33, 0xc8, 0x0a,
+   0x24, 0xc9, 0x2a, 0x15, 0xbb, 0x49, 0x84, 0xab, 0x40, 0x92, 0xac, 0x42, 0x91, 0x9d, 0x33, 0xc0,
+   0x0b, 0x34, 0xd9, 0x19, 0x23, 0xcb, 0x39, 0x05, 0xcb, 0x30, 0x94, 0xbb, 0x52, 0x91, 0x9c, 0x42,
+   0xa0, 0x8c, 0x43, 0xc8, 0x1a, 0x33, 0xdb, 0x29, 0x14, 0xcb, 0x20, 0x84, 0xbb, 0x60, 0x91, 0x9b,
+   0x52, 0xa0, 0x9b, 0x25, 0xb8, 0x1b, 0x34, 0xda, 0x29, 0x23, 0xcc, 0x38, 0x03, 0xad, 0x40, 0x92,
+   0x9c, 0x41, 0xa1, 0x8c, 0x42, 0xb0, 0x0c, 0x24, 0xb9, 0x3b, 0x14, 0xda, 0x28, 0x04, 0xac, 0x30,
+   0x93, 0x9d, 0x31, 0xb2, 0x9c, 0x53, 0xb0, 0x8b, 0x25, 0xc8, 0x1a, 0x14, 0xc9, 0x39, 0x03, 0xdb,
+   0x30, 0x83, 0xad, 0x31, 0xb3, 0x9d, 0x42, 0xb1, 0x0c, 0x42, 0xb8, 0x1b, 0x15, 0xc9, 0x29, 0x04,
+   0xba, 0x48, 0x02, 0xbc, 0x41, 0x92, 0x9d, 0x32, 0xb1, 0x0d, 0x32, 0xc8, 0x0a, 0x24, 0xc9, 0x19,
+   0x14, 0xca, 0x38, 0x83, 0xcb, 0x50, 0x81, 0x9c, 0x31, 0xb2, 0x9c, 0x43, 0xb0, 0x0c, 0x33, 0xd9,
+   0x19, 0x14, 0xca, 0x28, 0x84, 0xba, 0x40, 0x82, 0xac, 0x41, 0x91, 0x9c, 0x33, 0xb0, 0x0d, 0x23,
+   0xc8, 0x1a, 0x14, 0xd9, 0x18, 0x13, 0xcb, 0x20, 0x84, 0xbb, 0x51, 0x91, 0xab, 0x43, 0xa0, 0x8c,
+   0x14, 0xb0, 0x0a, 0x14, 0xc8, 0x29, 0x12, 0xca, 0x38, 0x82, 0xab, 0x40, 0x92, 0xab, 0x32, 0xa1,
+   0x8b, 0x32, 0xa8, 0x09, 0x51, 0x93, 0xff, 0x39, 0x36, 0xd8, 0x9d, 0x51, 0x03, 0xe9, 0x8b, 0x43,
+   0x84, 0xdb, 0x1a, 0x34, 0x92, 0xbe, 0x18, 0x35, 0xa8, 0xad, 0x40, 0x23, 0xd9, 0x9b, 0x51, 0x03,
+   0xda, 0x0a, 0x33, 0x82, 0xdc, 0x19, 0x43, 0x90, 0xac, 0x28, 0x15, 0xb0, 0x9c, 0x30, 0x24, 0xca,
+   0x8b, 0x52, 0x02, 0xdb, 0x09, 0x42, 0x92, 0xcb, 0x19, 0x34, 0xb1, 0xad, 0x38, 0x24, 0xb8, 0x9d,
+   0x31, 0x14, 0xda, 0x8a, 0x42, 0x83, 0xcb, 0x0a, 0x34, 0xa2, 0xad, 0x29, 0x34, 0xb0, 0xbc, 0x40,
+   0x33, 0xe9, 0x9a, 0x41, 0x03, 0xca, 0x0b, 0x52, 0x82, 0xac, 0x1a, 0x34, 0xa1, 0xbc, 0x39, 0x25,
+   0xb0, 0x9d, 0x48, 0x13, 0xb9, 0x9d, 0x42, 0x02, 0xda, 0x89, 0x43, 0x81, 0xcb, 0x2a, 0x34, 0xa0,
+   0xad, 0x38, 0x24, 0xb8, 0x9d, 0x40, 0x22, 0xca, 0x8b, 0x62, 0x01, 0xca, 0x1a, 0x42, 0x91, 0xcb,
+   0x18, 0x25, 0xa0, 0xac, 0x38, 0x24, 0xc8, 0xab, 0x52, 0x12, 0xca, 0x8b, 0x43, 0x83, 0xbc, 0x0a,
+   0x26, 0x91, 0xbc, 0x28, 0x34, 0xa8, 0xad, 0x40, 0x22, 0xc9, 0x9b, 0x42, 0x13, 0xdb, 0x8a, 0x53,
+   0x01, 0xbc, 0x19, 0x53, 0xa1, 0xac, 0x28, 0x15, 0xb0, 0x9c, 0x30, 0x24, 0xca, 0x8b, 0x52, 0x02,
+   0xcb, 0x0a, 0x53, 0x81, 0xac, 0x2a, 0x34, 0xa0, 0x9e, 0x28, 0x24, 0xa9, 0x9c, 0x31, 0x04, 0xd9,
+   0x8a, 0x42, 0x02, 0xcb, 0x0a, 0x34, 0xa2, 0xad, 0x29, 0x34, 0xb0, 0xbc, 0x40, 0x23, 0xe8, 0x9a,
+   0x41, 0x03, 0xca, 0x0b, 0x52, 0x82, 0xac, 0x1a, 0x34, 0xa1, 0xbc, 0x39, 0x25, 0xb0, 0x9d, 0x48,
+   0x13, 0xb9, 0x9d, 0x42, 0x02, 0xda, 0x89, 0x43, 0x81, 0xcb, 0x2a, 0x34, 0xa0, 0xad, 0x38, 0x24,
+   0xb8, 0x9d, 0x40, 0x22, 0xca, 0x8b, 0x62, 0x01, 0xca, 0x1a, 0x42, 0x91, 0xcb, 0x18, 0x25, 0xa0,
+   0xac, 0x38, 0x24, 0xc8, 0xab, 0x52, 0x12, 0xca, 0x8b, 0x43, 0x83, 0xbc, 0x0a, 0x26, 0x91, 0xbc,
+   0x28, 0x34, 0xa8, 0xad, 0x40, 0x22, 0xc9, 0x9b, 0x42, 0x13, 0xdb, 0x8a, 0x53, 0x01, 0xbc, 0x19,
+   0x53, 0xa1, 0xac, 0x28, 0x15, 0xb0, 0x9c, 0x30, 0x24, 0xca, 0x8b, 0x52, 0x02, 0xcb, 0x0a, 0x53,
+   0x81, 0xac, 0x2a, 0x34, 0xa0, 0x9e, 0x28, 0x24, 0xa9, 0x9c, 0x31, 0x04, 0xd9, 0x8a, 0x42, 0x02,
+   0xcb, 0x0a, 0x34, 0xa2, 0xad, 0x29, 0x34, 0xb0, 0xbc, 0x40, 0x23, 0xe8, 0x9a, 0x41, 0x03, 0xca,
+   0x0b, 0x52, 0x82, 0xac, 0x1a, 0x34, 0xa1, 0xbc, 0x39, 0x25, 0xb0, 0x9d, 0x48, 0x13, 0xb9, 0x9d,
+   0x42, 0x02, 0xda, 0x89, 0x43, 0x81, 0xcb, 0x2a, 0x34, 0xa0, 0xad, 0x38, 0x24, 0xb8, 0x9d, 0x40,
+   0x22, 0xca, 0x8b, 0x62, 0x01, 0xca, 0x1a, 0x42, 0x91, 0xcb, 0x18, 0x25, 0xa0, 0xac, 0x38, 0x24,
+   0xc8, 0xab, 0x52, 0x12, 0xca, 0x8b, 0x43, 0x83, 0xbc, 0x0a, 0x26, 0x91, 0xbc, 0x28, 0x34, 0xa8,
+   0xad, 0x40, 0x22, 0xc9, 0x9b, 0x42, 0x13, 0xdb, 0x8a, 0x53, 0x01, 0xbc, 0x19, 0x53, 0xa1, 0xac,
+   0x28, 0x15, 0xb0, 0x9c, 0x30, 0x24, 0xca, 0x8b, 0x52, 0x02, 0xcb, 0x0a, 0x53, 0x81, 0xac, 0x2a,
+   0x34, 0xa0, 0x9e, 0x28, 0x24, 0xa9, 0x9c, 0x31, 0x04, 0xd9, 0x8a, 0x42, 0x02, 0xcb, 0x0a, 0x34,
+   0xa2, 0xad, 0x29, 0x34, 0xb0, 0xbc, 0x40, 0x23, 0xe8, 0x9a, 0x41, 0x03, 0xca, 0x0b, 0x52, 0x82,
+   0xac, 0x1a, 0x34, 0xa1, 0xbc, 0x39, 0x25, 0xb0, 0x9d, 0x48, 0x13, 0xb9, 0x9d, 0x42, 0x02, 0xda,
+   0x89, 0x43, 0x81, 0xcb, 0x2a, 0x34, 0xa0, 0xad, 0x38, 0x24, 0xb8, 0x9d, 0x40, 0x22, 0xca, 0x8b,
+   0x62, 0x01, 0xca, 0x1a, 0x42, 0x91, 0xcb, 0x18, 0x25, 0xa0, 0xac, 0x38, 0x24, 0xc8, 0xab, 0x52,
+   0x12, 0xca, 0x8b, 0x43, 0x83, 0xbc, 0x0a, 0x26, 0x91, 0xbc, 0x28, 0x34, 0xa8, 0xad, 0x40, 0x22,
+   0xc9, 0x9b, 0x42, 0x13, 0xdb, 0x8a, 0x53, 0x01, 0xbc, 0x19, 0x53, 0xa1, 0xac, 0x28, 0x15, 0xb0,
+   0x9c, 0x30, 0x24, 0xca, 0x8b, 0x52, 0x02, 0xcb, 0x0a, 0x53, 0x81, 0xac, 0x2a, 0x34, 0xa0, 0x9e,
+   0x28, 0x24, 0xa9, 0x9c, 0x31, 0x04, 0xd9, 0x8a, 0x42, 0x02, 0xcb, 0x0a, 0x34, 0xa2, 0xad, 0x29,
+   0x34, 0xb0, 0xbc, 0x40, 0x23, 0xe8, 0x9a, 0x41, 0x03, 0xca, 0x0b, 0x52, 0x82, 0xac, 0x1a, 0x34,
+   0xa1, 0xbc, 0x39, 0x25, 0xb0, 0x9d, 0x48, 0x13, 0xb9, 0x9d, 0x42, 0x02, 0xda, 0x89, 0x43, 0x81,
+   0xcb, 0x2a, 0x34, 0xa0, 0xad, 0x38, 0x24, 0xb8, 0x9d, 0x40, 0x22, 0xca, 0x8b, 0x62, 0x01, 0xca,
+   0x1a, 0x42, 0x91, 0xcb, 0x18, 0x25, 0xa0, 0xac, 0x20, 0x24, 0xb9, 0x9c, 0x41, 0x13, 0xda, 0x0b,
+   0x42, 0x82, 0xcb, 0x1a, 0x34, 0xa2, 0xbd, 0x28, 0x34, 0xb0, 0xad, 0x40, 0x22, 0xc9, 0x9b, 0x42,
+   0x03, 0xda, 0x8a, 0x34, 0x81, 0xbc, 0x19, 0x34, 0xa1, 0xad, 0x28, 0x15, 0xb0, 0x9c, 0x30, 0x14,
+   0xb9, 0x9c, 0x43, 0x02, 0xdb, 0x0a, 0x43, 0x92, 0xcb, 0x19, 0x34, 0xb1, 0xad, 0x38, 0x24, 0xb8,
+   0xac, 0x41, 0x13, 0xda, 0x8a, 0x42, 0x02, 0xcb, 0x0a, 0x34, 0x91, 0xad, 0x18, 0x34, 0xa8, 0xac,
+   0x30, 0x14, 0xc8, 0x9b, 0x51, 0x02, 0xc9, 0x8a, 0x33, 0x83, 0xbd, 0x1a, 0x35, 0x90, 0xbc, 0x38,
+   0x33, 0xc0, 0xac, 0x40, 0x13, 0xb9, 0x8d, 0x31, 0x03, 0xcb, 0x8a, 0x44, 0x91, 0xca, 0x19, 0x33,
+   0xb1, 0xac, 0x38, 0x15, 0xa8, 0x9c, 0x21, 0x13, 0xba, 0x8b, 0x43, 0x82, 0xca, 0x09, 0x22, 0x91,
+   0x99, 0x18,
+};
+
+#endif
@@ -0,0 +1,22 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 3; tab-width: 3 -*- */
+/* vim: set tabstop=3 softtabstop=3 shiftwidth=3 expandtab :               */
+/*
+ * voice_clip.h
+ *
+ * Voice ID clip Header file
+ *
+ * The clip itself is in voice_clip.c, generated by
+ * tools/wav2adpcm, see make voice.
+ *
+ * José Miguel Fonte
+ */
+
+#ifndef _VOICE_CLIP_H_
+#define _VOICE_CLIP_H_
+
+#include <stdint.h>
+
+extern const uint8_t voice_clip[];
+extern const unsigned int voice_clip_samples;
+
+#endif /* _VOICE_CLIP_H_ */